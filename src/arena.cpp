@@ -0,0 +1,219 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+ArenaGrid::ArenaGrid(std::size_t width, std::size_t height)
+    : width(width), height(height), cells(width * height, EMPTY), free_cells(width * height), free_slot(width * height), free_count(width * height) {
+    for (std::uint32_t i = 0; i < free_cells.size(); ++i) {
+        free_cells[i] = i;
+        free_slot[i] = i;
+    }
+}
+
+void ArenaGrid::set_cell(std::size_t cell, cell_type value) {
+    const bool was_free = cells[cell] == EMPTY;
+    cells[cell] = value;
+    if (was_free == (value == EMPTY)) return;
+
+    if (was_free) {
+        const std::uint32_t slot = free_slot[cell];
+        const std::uint32_t last = free_cells[--free_count];
+        free_cells[slot] = last;
+        free_slot[last] = slot;
+    } else {
+        free_slot[cell] = static_cast<std::uint32_t>(free_count);
+        free_cells[free_count++] = static_cast<std::uint32_t>(cell);
+    }
+}
+
+std::size_t ArenaGrid::random_free_cell(Xoshiro256 &rng) const {
+    return free_cells[random_below(rng, free_count)];
+}
+
+Arena::Arena(std::size_t width, std::size_t height, std::size_t apple_count, std::uint64_t seed)
+    : grid(width, height), apples(apple_count, NO_APPLE), apple_slots(width * height), claims(width * height), rng(seed) {
+    for (std::size_t slot = 0; slot < apples.size(); ++slot) {
+        spawn_apple(slot);
+    }
+}
+
+std::optional<std::size_t> Arena::add_snake(Position head, Direction heading, std::size_t length) {
+    if (snakes.size() >= ArenaGrid::MAX_SNAKES || length == 0) return std::nullopt;
+    if (head.row >= grid.get_height() || head.col >= grid.get_width()) return std::nullopt;
+
+    // Check the whole body before touching the grid.
+    const auto behind = static_cast<Direction>((static_cast<int>(heading) + 2) % 4);
+    Position tail = head;
+    for (std::size_t i = 0;; ++i) {
+        if (grid.get_cell(grid.to_cell(tail)) != ArenaGrid::EMPTY) return std::nullopt;
+        if (i + 1 == length) break;
+
+        const std::optional<Position> next = grid_step(tail, behind);
+        if (!next) return std::nullopt;
+        tail = *next;
+    }
+
+    const std::size_t id = snakes.size();
+    ArenaSnake &snake = snakes.emplace_back();
+    snake.direction = heading;
+    snake.next_direction = heading;
+
+    Position position = tail;
+    for (std::size_t i = 0; i < length; ++i) {
+        snake.body.push_front(position);
+        grid.set_cell(grid.to_cell(position), ArenaGrid::owner_cell(id));
+        if (i + 1 < length) position = *grid_step(position, heading);
+    }
+
+    proposals.emplace_back();
+    ++alive_count;
+    return id;
+}
+
+std::optional<Position> Arena::grid_step(Position position, Direction direction) const {
+    return step_position(position, direction, grid.get_width(), grid.get_height());
+}
+
+void Arena::steer(std::size_t snake, Direction direction) {
+    ArenaSnake &steered = snakes[snake];
+    if (!is_opposite(steered.direction, direction)) steered.next_direction = direction;
+}
+
+void Arena::tick() {
+    for (std::size_t snake = 0; snake < snakes.size(); ++snake) propose(snake);
+    for (std::size_t snake = 0; snake < snakes.size(); ++snake) resolve(snake);
+    commit();
+}
+
+void Arena::tick(WorkStealingPool &pool) {
+    // Both passes only write the snake's own proposal (and its atomic claim),
+    // and each parallel_for returning is the barrier between them.
+    const std::size_t blocks = (snakes.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const auto run_pass = [&](void (Arena::*pass)(std::size_t)) {
+        pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+            const std::size_t end = std::min(snakes.size(), (block + 1) * BLOCK_SIZE);
+            for (std::size_t snake = block * BLOCK_SIZE; snake < end; ++snake) (this->*pass)(snake);
+        });
+    };
+    run_pass(&Arena::propose);
+    run_pass(&Arena::resolve);
+    commit();
+}
+
+void Arena::propose(std::size_t snake) {
+    const ArenaSnake &moving = snakes[snake];
+    Proposal &proposal = proposals[snake];
+    proposal = {0, DeathCause::NONE, false};
+    if (!moving.alive) return;
+
+    if (const std::optional<Position> target = grid_step(moving.body.front(), moving.next_direction)) {
+        proposal.target = grid.to_cell(*target);
+        proposal.eats = grid.get_cell(proposal.target) == ArenaGrid::APPLE;
+        // At most four heads can reach a cell, so the count cannot overflow.
+        std::atomic_ref(claims[proposal.target]).fetch_add(1, std::memory_order_relaxed);
+    } else {
+        proposal.death = DeathCause::WALL;
+    }
+}
+
+void Arena::resolve(std::size_t snake) {
+    Proposal &proposal = proposals[snake];
+    if (!snakes[snake].alive || proposal.death != DeathCause::NONE) return;
+
+    if (claims[proposal.target] > 1) {
+        proposal.death = DeathCause::HEAD_ON;
+        return;
+    }
+
+    const ArenaGrid::cell_type occupant = grid.get_cell(proposal.target);
+    if (!ArenaGrid::is_owned(occupant)) return;
+
+    const std::size_t owner = ArenaGrid::cell_owner(occupant);
+    const ArenaSnake &owner_snake = snakes[owner];
+    if (owner != snake && grid.to_cell(owner_snake.body.front()) == proposal.target) {
+        // Two heads moving into each other's cells meet head-on, even if the
+        // other head is also its tail and would otherwise count as vacated.
+        const std::optional<Position> owner_target = grid_step(owner_snake.body.front(), owner_snake.next_direction);
+        if (owner_target && *owner_target == snakes[snake].body.front()) {
+            proposal.death = DeathCause::HEAD_ON;
+            return;
+        }
+    }
+
+    const bool vacated_tail = !proposals[owner].eats && grid.to_cell(owner_snake.body.back()) == proposal.target;
+    if (!vacated_tail) {
+        proposal.death = owner == snake ? DeathCause::SELF : DeathCause::OTHER;
+    }
+}
+
+void Arena::commit() {
+    // Bodies of the dead go first, then vacated tails, then the new heads,
+    // so a head may take over any cell freed this tick.
+    for (std::size_t snake = 0; snake < snakes.size(); ++snake) {
+        ArenaSnake &dying = snakes[snake];
+        dying.events = {};
+        if (!dying.alive) continue;
+
+        const Proposal &proposal = proposals[snake];
+        claims[proposal.target] = 0;
+        if (proposal.death == DeathCause::NONE) continue;
+
+        dying.alive = false;
+        dying.events.death = proposal.death;
+        --alive_count;
+        while (dying.body.size() > 0) {
+            grid.set_cell(grid.to_cell(dying.body.back()), ArenaGrid::EMPTY);
+            dying.body.pop_back();
+        }
+    }
+
+    for (std::size_t snake = 0; snake < snakes.size(); ++snake) {
+        ArenaSnake &moving = snakes[snake];
+        if (!moving.alive || proposals[snake].eats) continue;
+
+        moving.events.freed_tail = moving.body.back();
+        grid.set_cell(grid.to_cell(moving.body.back()), ArenaGrid::EMPTY);
+        moving.body.pop_back();
+    }
+
+    for (std::size_t snake = 0; snake < snakes.size(); ++snake) {
+        ArenaSnake &moving = snakes[snake];
+        if (!moving.alive) continue;
+
+        const Proposal &proposal = proposals[snake];
+        const Position head = grid.to_position(proposal.target);
+        if (proposal.eats) moving.events.freed_tail = moving.body.back();
+        moving.body.push_front(head);
+        grid.set_cell(proposal.target, ArenaGrid::owner_cell(snake));
+        moving.direction = moving.next_direction;
+
+        moving.events.moved = true;
+        moving.events.head = head;
+        if (proposal.eats) {
+            const std::size_t slot = apple_slots[proposal.target];
+            spawn_apple(slot);
+            moving.events.grew = true;
+            // Left unset if the slot stayed empty.
+            if (apples[slot] != NO_APPLE) moving.events.apple = grid.to_position(apples[slot]);
+        }
+    }
+
+    while (!empty_slots.empty() && grid.get_free_cell_count() > 0) {
+        const std::size_t slot = empty_slots.back();
+        empty_slots.pop_back();
+        spawn_apple(slot);
+    }
+}
+
+void Arena::spawn_apple(std::size_t slot) {
+    if (grid.get_free_cell_count() == 0) {
+        apples[slot] = NO_APPLE;
+        empty_slots.push_back(slot);
+        return;
+    }
+
+    apples[slot] = grid.random_free_cell(rng);
+    apple_slots[apples[slot]] = static_cast<std::uint32_t>(slot);
+    grid.set_cell(apples[slot], ArenaGrid::APPLE);
+}
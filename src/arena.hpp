@@ -0,0 +1,135 @@
+#pragma once
+
+#include "snake.hpp"
+#include "random.hpp"
+#include "thread_pool.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Board shared by many snakes. Each cell holds the id of the snake occupying
+// it (or an apple), and free cells are tracked in a dense index like
+// SnakeGrid's so apples respawn in O(1).
+class ArenaGrid {
+public:
+    using cell_type = std::uint16_t;
+
+    static constexpr cell_type EMPTY = 0;
+    static constexpr cell_type APPLE = 0xFFFF;
+    // Snake ids are stored shifted by one so EMPTY stays zero.
+    static constexpr std::size_t MAX_SNAKES = APPLE - 1;
+
+    ArenaGrid(std::size_t width, std::size_t height);
+
+    std::size_t get_width() const { return width; }
+    std::size_t get_height() const { return height; }
+    std::size_t to_cell(Position position) const { return position.row * width + position.col; }
+    Position to_position(std::size_t cell) const {
+        return {static_cast<std::uint16_t>(cell / width), static_cast<std::uint16_t>(cell % width)};
+    }
+
+    cell_type get_cell(std::size_t cell) const { return cells[cell]; }
+    void set_cell(std::size_t cell, cell_type value);
+
+    static cell_type owner_cell(std::size_t snake) { return static_cast<cell_type>(snake + 1); }
+    static std::size_t cell_owner(cell_type value) { return value - 1u; }
+    static bool is_owned(cell_type value) { return value != EMPTY && value != APPLE; }
+
+    std::size_t get_free_cell_count() const { return free_count; }
+    // Picks a uniformly random empty cell; there must be one.
+    std::size_t random_free_cell(Xoshiro256 &rng) const;
+
+private:
+    std::size_t width;
+    std::size_t height;
+    std::vector<cell_type> cells;
+    std::vector<std::uint32_t> free_cells;
+    std::vector<std::uint32_t> free_slot;
+    std::size_t free_count;
+};
+
+// Many snakes moving simultaneously on one ArenaGrid.
+//
+// Each tick every live snake moves one cell. Collisions are judged against
+// the bodies as they were at the start of the tick, except that a snake
+// which is not eating vacates its tail cell, which others may enter. Two or
+// more heads entering the same cell, or two heads moving into each other's
+// cells, all die (HEAD_ON); a head entering any other body cell dies (SELF
+// or OTHER). Bodies of snakes that die are
+// removed at the end of the tick. All work is per snake, never per cell of
+// the board.
+class Arena {
+public:
+    Arena(std::size_t width, std::size_t height, std::size_t apple_count, std::uint64_t seed);
+
+    // Apple slot left empty because the board was full; refilled once cells free up.
+    static constexpr std::size_t NO_APPLE = ~std::size_t{0};
+
+    // Adds a snake whose head is at head and whose body trails behind it,
+    // opposite to heading, and returns its id. Fails, leaving the arena
+    // unchanged, if a cell is off the board or not empty, the length is
+    // zero, or the arena already holds MAX_SNAKES snakes.
+    std::optional<std::size_t> add_snake(Position head, Direction heading, std::size_t length = 4);
+
+    // Direction for the next tick; reversing onto the body is ignored.
+    void steer(std::size_t snake, Direction direction);
+
+    void tick();
+    // Same result as tick(), with the propose and resolve passes spread over
+    // the pool in blocks of snakes. Only the commit runs on one thread.
+    void tick(WorkStealingPool &pool);
+
+    const ArenaGrid &get_grid() const { return grid; }
+    std::size_t get_snake_count() const { return snakes.size(); }
+    std::size_t get_alive_count() const { return alive_count; }
+    // Apple cells by slot, NO_APPLE for empty slots.
+    std::span<const std::size_t> get_apples() const { return apples; }
+
+    bool is_alive(std::size_t snake) const { return snakes[snake].alive; }
+    BodyView get_body(std::size_t snake) const { return snakes[snake].body.view(); }
+    Direction get_direction(std::size_t snake) const { return snakes[snake].direction; }
+    // What the last tick did to this snake.
+    const TickEvents &get_events(std::size_t snake) const { return snakes[snake].events; }
+
+private:
+    struct ArenaSnake {
+        RingBody body;
+        Direction direction;
+        Direction next_direction;
+        bool alive = true;
+        TickEvents events;
+    };
+
+    // Where a snake's head goes this tick, decided from start-of-tick state only.
+    struct Proposal {
+        std::size_t target;
+        DeathCause death;
+        bool eats;
+    };
+
+    std::optional<Position> grid_step(Position position, Direction direction) const;
+    // Also registers the head's claim on its target cell, which is why claims
+    // are counted atomically.
+    void propose(std::size_t snake);
+    void resolve(std::size_t snake);
+    void commit();
+    void spawn_apple(std::size_t slot);
+
+    static constexpr std::size_t BLOCK_SIZE = 256;
+
+    ArenaGrid grid;
+    std::vector<ArenaSnake> snakes;
+    std::vector<Proposal> proposals;
+    std::vector<std::size_t> apples;
+    // Slot of the apple on each cell, valid where the cell holds an apple, so
+    // eating one finds its slot in O(1).
+    std::vector<std::uint32_t> apple_slots;
+    std::vector<std::size_t> empty_slots;
+    // Heads claiming each cell this tick; only proposed cells are touched and
+    // they are reset in commit.
+    std::vector<std::uint8_t> claims;
+    std::size_t alive_count = 0;
+    Xoshiro256 rng;
+};
@@ -0,0 +1,133 @@
+#include "batch.hpp"
+
+#include "bitboard.hpp"
+
+#include <bit>
+
+SnakeBatch::SnakeBatch(std::size_t games, std::size_t width, std::size_t height, std::uint64_t seed)
+    : width(width), height(height), words_per_game(word_count(width * height)), ring_capacity(std::bit_ceil(width * height)),
+      occupancy(games * words_per_game), rings(games * ring_capacity), ring_heads(games), lengths(games),
+      head_rows(games), head_cols(games), apples(games), directions(games), deaths(games), won(games), grew(games),
+      next_directions(games), next_cells(games), in_bounds(games) {
+    rngs.reserve(games);
+    for (std::size_t game = 0; game < games; ++game) {
+        rngs.emplace_back(splitmix64(seed));
+        reset(game);
+    }
+}
+
+void SnakeBatch::reset(std::size_t game) {
+    std::uint64_t *game_words = words(game);
+    std::fill_n(game_words, words_per_game, 0);
+    if (const std::size_t used_bits = width * height % WORD_BITS) {
+        game_words[words_per_game - 1] = ~std::uint64_t{0} << used_bits;
+    }
+
+    // Same start as a Snake at (height / 2, 4) on a fresh grid.
+    const std::size_t row = height / 2;
+    std::uint32_t *game_ring = ring(game);
+    for (std::size_t i = 0; i < 4; ++i) {
+        const auto cell = static_cast<std::uint32_t>(row * width + 4 - i);
+        game_ring[i] = cell;
+        game_words[cell / WORD_BITS] |= std::uint64_t{1} << (cell % WORD_BITS);
+    }
+    ring_heads[game] = 0;
+    lengths[game] = 4;
+    head_rows[game] = static_cast<std::uint16_t>(row);
+    head_cols[game] = 4;
+    apples[game] = static_cast<std::uint32_t>(row * width + width - 3);
+    directions[game] = static_cast<std::uint8_t>(Direction::RIGHT);
+    deaths[game] = DeathCause::NONE;
+    won[game] = false;
+    grew[game] = false;
+}
+
+void SnakeBatch::step(std::span<const Direction> actions) {
+    const std::size_t games = size();
+    const auto rows = static_cast<int>(height);
+    const auto cols = static_cast<int>(width);
+
+    // Turn and propose the next head for every game. Branch-free over plain
+    // arrays, so the compiler can vectorize the bounds checks; proposals of
+    // finished games are ignored below.
+    for (std::size_t game = 0; game < games; ++game) {
+        const auto wanted = static_cast<std::uint8_t>(actions[game]);
+        const std::uint8_t last = directions[game];
+        // RIGHT/LEFT and DOWN/UP differ by two.
+        const std::uint8_t direction = (wanted ^ last) == 2 ? last : wanted;
+
+        const int row = head_rows[game] + (direction == 1) - (direction == 3);
+        const int col = head_cols[game] + (direction == 0) - (direction == 2);
+
+        next_directions[game] = direction;
+        in_bounds[game] = (row >= 0) & (row < rows) & (col >= 0) & (col < cols);
+        next_cells[game] = static_cast<std::uint32_t>(row * cols + col);
+        grew[game] = false;
+    }
+
+    const std::size_t mask = ring_capacity - 1;
+    for (std::size_t game = 0; game < games; ++game) {
+        if (!is_alive(game)) continue;
+        if (!in_bounds[game]) {
+            deaths[game] = DeathCause::WALL;
+            continue;
+        }
+
+        std::uint64_t *game_words = words(game);
+        std::uint32_t *game_ring = ring(game);
+        const std::uint32_t cell = next_cells[game];
+        const std::uint32_t tail = game_ring[(ring_heads[game] + lengths[game] - 1) & mask];
+        const bool occupied = (game_words[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1;
+        if (occupied && cell != tail) {
+            deaths[game] = DeathCause::SELF;
+            continue;
+        }
+
+        const bool eaten_apple = cell == apples[game];
+        if (eaten_apple) {
+            ++lengths[game];
+        } else {
+            game_words[tail / WORD_BITS] &= ~(std::uint64_t{1} << (tail % WORD_BITS));
+        }
+        ring_heads[game] = static_cast<std::uint32_t>((ring_heads[game] - 1) & mask);
+        game_ring[ring_heads[game]] = cell;
+        game_words[cell / WORD_BITS] |= std::uint64_t{1} << (cell % WORD_BITS);
+        head_rows[game] = static_cast<std::uint16_t>(cell / width);
+        head_cols[game] = static_cast<std::uint16_t>(cell % width);
+        directions[game] = next_directions[game];
+
+        if (eaten_apple) {
+            grew[game] = true;
+            const std::size_t free_cells = width * height - lengths[game];
+            // The body fills the board: nowhere left for an apple.
+            if (free_cells == 0) {
+                won[game] = true;
+                continue;
+            }
+
+            const std::size_t k = random_below(rngs[game], free_cells);
+            apples[game] = static_cast<std::uint32_t>(select_clear_bit({game_words, words_per_game}, k));
+        }
+    }
+}
+
+Position SnakeBatch::get_segment(std::size_t game, std::size_t index) const {
+    return to_position(rings[game * ring_capacity + ((ring_heads[game] + index) & (ring_capacity - 1))]);
+}
+
+std::span<const std::uint64_t> SnakeBatch::get_occupancy(std::size_t game) const {
+    return {occupancy.data() + game * words_per_game, words_per_game};
+}
+
+bool SnakeBatch::matches(std::size_t game, const Snake &snake, const SnakeGrid &grid) const {
+    if (snake.has_state<AliveSnake>() != is_alive(game) || snake.has_state<WinnerSnake>() != has_won(game)) return false;
+    if (!(grid.get_apple_position() == get_apple_position(game))) return false;
+
+    const BodyView body = snake.get_body();
+    if (body.size() != get_length(game)) return false;
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        if (!(body[i] == get_segment(game, i))) return false;
+    }
+
+    return std::ranges::equal(grid.get_occupancy(), get_occupancy(game));
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "snake.hpp"
+#include "random.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Many independent single-player games on same-sized boards, stored as
+// structure-of-arrays and stepped in lockstep by one step() call.
+//
+// The rules are those of BasicSnake::update. Games start heading right and
+// the first step already moves them; a fresh Snake would instead wait in
+// PreStartSnake for its first push_direction. A game that dies, or wins by
+// filling the board, stays finished until reset. Apples respawn on the k-th free cell in row-major order
+// instead of through a free-cell index, which would cost several bytes per
+// cell per game.
+class SnakeBatch {
+public:
+    SnakeBatch(std::size_t games, std::size_t width, std::size_t height, std::uint64_t seed);
+
+    // Back to the starting body and apple; the game's RNG keeps running.
+    void reset(std::size_t game);
+
+    // One tick for every game still running. An action opposite to a game's heading
+    // is ignored, as push_direction would.
+    void step(std::span<const Direction> actions);
+
+    std::size_t size() const { return lengths.size(); }
+    std::size_t get_width() const { return width; }
+    std::size_t get_height() const { return height; }
+
+    bool is_alive(std::size_t game) const { return deaths[game] == DeathCause::NONE && !won[game]; }
+    DeathCause get_death(std::size_t game) const { return deaths[game]; }
+    // Whether the body fills the board, as with WinnerSnake.
+    bool has_won(std::size_t game) const { return won[game]; }
+    // Whether the game ate an apple on the last step.
+    bool has_grown(std::size_t game) const { return grew[game]; }
+
+    std::size_t get_length(std::size_t game) const { return lengths[game]; }
+    Direction get_direction(std::size_t game) const { return static_cast<Direction>(directions[game]); }
+    Position get_segment(std::size_t game, std::size_t index) const;
+    Position get_apple_position(std::size_t game) const { return to_position(apples[game]); }
+    std::span<const std::uint64_t> get_occupancy(std::size_t game) const;
+
+    // Whether a scalar game is in the same state as this one. For lockstep
+    // cross-checks, copy each respawned apple into the grid with place_apple.
+    bool matches(std::size_t game, const Snake &snake, const SnakeGrid &grid) const;
+
+private:
+    Position to_position(std::uint32_t cell) const {
+        return {static_cast<std::uint16_t>(cell / width), static_cast<std::uint16_t>(cell % width)};
+    }
+
+    std::uint32_t *ring(std::size_t game) { return rings.data() + game * ring_capacity; }
+    std::uint64_t *words(std::size_t game) { return occupancy.data() + game * words_per_game; }
+
+    std::size_t width;
+    std::size_t height;
+    std::size_t words_per_game;
+    std::size_t ring_capacity;
+
+    // Per-game state, one entry per game unless noted.
+    std::vector<std::uint64_t> occupancy; // words_per_game per game
+    std::vector<std::uint32_t> rings;     // ring_capacity cells per game, head first
+    std::vector<std::uint32_t> ring_heads;
+    std::vector<std::uint32_t> lengths;
+    std::vector<std::uint16_t> head_rows;
+    std::vector<std::uint16_t> head_cols;
+    std::vector<std::uint32_t> apples;
+    std::vector<std::uint8_t> directions;
+    std::vector<DeathCause> deaths;
+    std::vector<std::uint8_t> won;
+    std::vector<std::uint8_t> grew;
+    std::vector<Xoshiro256> rngs;
+
+    // Scratch for the proposal pass.
+    std::vector<std::uint8_t> next_directions;
+    std::vector<std::uint32_t> next_cells;
+    std::vector<std::uint8_t> in_bounds;
+};
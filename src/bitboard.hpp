@@ -0,0 +1,38 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+constexpr inline std::size_t WORD_BITS = 64;
+
+constexpr std::size_t word_count(std::size_t bits) {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+// Index of the k-th (zero based) set bit of word. k must be below popcount(word).
+inline unsigned select_bit(std::uint64_t word, unsigned k) {
+#if defined(__BMI2__)
+    return static_cast<unsigned>(std::countr_zero(_pdep_u64(std::uint64_t{1} << k, word)));
+#else
+    for (; k > 0; --k) word &= word - 1;
+    return static_cast<unsigned>(std::countr_zero(word));
+#endif
+}
+
+// Bit index of the k-th (zero based) clear bit, skipping whole words by popcount.
+// k must be below the number of clear bits.
+inline std::size_t select_clear_bit(std::span<const std::uint64_t> words, std::size_t k) {
+    std::size_t i = 0;
+    for (;; ++i) {
+        const auto clear = static_cast<std::size_t>(std::popcount(~words[i]));
+        if (k < clear) break;
+        k -= clear;
+    }
+    return i * WORD_BITS + select_bit(~words[i], static_cast<unsigned>(k));
+}
@@ -0,0 +1,135 @@
+#include "chunked_grid.hpp"
+
+#include <algorithm>
+#include <bit>
+
+template <std::unsigned_integral Coord>
+BasicChunkedSnakeGrid<Coord>::BasicChunkedSnakeGrid(std::size_t width, std::size_t height, std::uint64_t seed)
+    : width(width), height(height), chunk_columns((width + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      chunk_table(chunk_columns * ((height + CHUNK_SIZE - 1) / CHUNK_SIZE), NO_CHUNK),
+      apple{static_cast<Coord>(height / 2), static_cast<Coord>(width - 3)},
+      hash(zobrist_key(ZobristFeature::APPLE, to_cell(apple))),
+      rng(seed) {}
+
+template <std::unsigned_integral Coord>
+void BasicChunkedSnakeGrid<Coord>::set_snake_body(position_type position, bool value) {
+    const std::size_t chunk = chunk_of(position);
+    std::uint32_t &index = chunk_table[chunk];
+    if (index == NO_CHUNK) {
+        if (!value) return;
+        index = static_cast<std::uint32_t>(chunks.size());
+        chunks.emplace_back();
+        chunk_owners.push_back(static_cast<std::uint32_t>(chunk));
+    }
+
+    Chunk &cells = chunks[index];
+    const std::uint64_t mask = std::uint64_t{1} << (position.col % CHUNK_SIZE);
+    std::uint64_t &row = cells.rows[position.row % CHUNK_SIZE];
+    if (((row & mask) != 0) == value) return;
+    row ^= mask;
+    hash ^= zobrist_key(ZobristFeature::BODY, to_cell(position));
+
+    if (value) {
+        ++cells.count;
+        ++occupied;
+    } else {
+        --occupied;
+        if (--cells.count == 0) {
+            release_chunk(index);
+            index = NO_CHUNK;
+        }
+    }
+}
+
+template <std::unsigned_integral Coord>
+void BasicChunkedSnakeGrid<Coord>::release_chunk(std::uint32_t index) {
+    if (index + std::size_t{1} < chunks.size()) {
+        chunks[index] = chunks.back();
+        chunk_owners[index] = chunk_owners.back();
+        chunk_table[chunk_owners[index]] = index;
+    }
+    chunks.pop_back();
+    chunk_owners.pop_back();
+
+    // Give the storage back once the snakes have shrunk well below their
+    // peak; waiting for a quarter keeps this amortized O(1) per chunk.
+    if (chunks.capacity() >= 64 && chunks.size() * 4 <= chunks.capacity()) {
+        chunks.shrink_to_fit();
+        chunk_owners.shrink_to_fit();
+    }
+}
+
+template <std::unsigned_integral Coord>
+bool BasicChunkedSnakeGrid<Coord>::operator==(const BasicChunkedSnakeGrid &other) const {
+    if (width != other.width || height != other.height || occupied != other.occupied || !(apple == other.apple) || !(rng == other.rng)) {
+        return false;
+    }
+
+    // Empty chunks are never allocated, so both tables have the same entries
+    // free and the allocated ones must hold the same cells.
+    for (std::size_t chunk = 0; chunk < chunk_table.size(); ++chunk) {
+        const std::uint32_t index = chunk_table[chunk];
+        const std::uint32_t other_index = other.chunk_table[chunk];
+        if ((index == NO_CHUNK) != (other_index == NO_CHUNK)) return false;
+        if (index != NO_CHUNK && chunks[index].rows != other.chunks[other_index].rows) return false;
+    }
+    return true;
+}
+
+template <std::unsigned_integral Coord>
+void BasicChunkedSnakeGrid<Coord>::shuffle_apple() {
+    const std::size_t free_cells = get_free_cell_count();
+    if (free_cells == 0) return;
+
+    // On a mostly empty board a few uniform draws almost always hit a free cell.
+    constexpr int REJECTION_ATTEMPTS = 64;
+    for (int attempt = 0; attempt < REJECTION_ATTEMPTS; ++attempt) {
+        const position_type position = to_position(random_below(rng, width * height));
+        if (!is_snake_body(position)) {
+            place_apple(position);
+            return;
+        }
+    }
+
+    place_apple(nth_free_cell(random_below(rng, free_cells)));
+}
+
+template <std::unsigned_integral Coord>
+std::size_t BasicChunkedSnakeGrid<Coord>::chunk_rows(std::size_t chunk) const {
+    return std::min(CHUNK_SIZE, height - chunk / chunk_columns * CHUNK_SIZE);
+}
+
+template <std::unsigned_integral Coord>
+std::size_t BasicChunkedSnakeGrid<Coord>::chunk_cols(std::size_t chunk) const {
+    return std::min(CHUNK_SIZE, width - chunk % chunk_columns * CHUNK_SIZE);
+}
+
+template <std::unsigned_integral Coord>
+auto BasicChunkedSnakeGrid<Coord>::nth_free_cell(std::size_t k) const -> position_type {
+    static constexpr Chunk EMPTY_CHUNK{};
+
+    for (std::size_t chunk = 0;; ++chunk) {
+        const std::size_t rows = chunk_rows(chunk);
+        const std::size_t cols = chunk_cols(chunk);
+        const Chunk &cells = chunk_table[chunk] == NO_CHUNK ? EMPTY_CHUNK : chunks[chunk_table[chunk]];
+        const std::size_t free_cells = rows * cols - cells.count;
+        if (k >= free_cells) {
+            k -= free_cells;
+            continue;
+        }
+
+        const std::uint64_t col_mask = cols == WORD_BITS ? ~std::uint64_t{0} : (std::uint64_t{1} << cols) - 1;
+        for (std::size_t row = 0;; ++row) {
+            const std::uint64_t free_bits = ~cells.rows[row] & col_mask;
+            const auto row_free = static_cast<std::size_t>(std::popcount(free_bits));
+            if (k < row_free) {
+                return {static_cast<Coord>(chunk / chunk_columns * CHUNK_SIZE + row),
+                        static_cast<Coord>(chunk % chunk_columns * CHUNK_SIZE + select_bit(free_bits, static_cast<unsigned>(k)))};
+            }
+            k -= row_free;
+        }
+    }
+}
+
+template class BasicChunkedSnakeGrid<std::uint16_t>;
+template class BasicChunkedSnakeGrid<std::uint32_t>;
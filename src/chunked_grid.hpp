@@ -0,0 +1,104 @@
+#pragma once
+
+#include "grid.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Grid for giant, mostly empty boards. Occupancy lives in 64x64 chunks that
+// are allocated on first write and freed once empty, so memory follows the
+// snakes' current footprint instead of the board area or their peak. The
+// only per-area cost is the chunk table, four bytes per chunk, which keeps
+// cell access O(1).
+//
+// Apples are placed by rejection sampling over the whole board, falling back
+// to an exact walk over per-chunk free counts when the board is nearly full.
+template <std::unsigned_integral Coord = std::uint32_t>
+class BasicChunkedSnakeGrid {
+public:
+    using coord_type = Coord;
+    using position_type = BasicPosition<Coord>;
+
+    // Cells per chunk side; one word holds one chunk row.
+    static constexpr std::size_t CHUNK_SIZE = WORD_BITS;
+
+    BasicChunkedSnakeGrid(std::size_t width, std::size_t height, std::uint64_t seed);
+
+    void set_snake_body(position_type position, bool value);
+
+    bool is_snake_body(position_type position) const {
+        const std::uint32_t index = chunk_table[chunk_of(position)];
+        return index != NO_CHUNK && (chunks[index].rows[position.row % CHUNK_SIZE] >> (position.col % CHUNK_SIZE)) & 1;
+    }
+
+    std::optional<position_type> move_head(position_type head, Direction direction) const {
+        return step_position(head, direction, width, height);
+    }
+
+    std::size_t get_width() const { return width; }
+    std::size_t get_height() const { return height; }
+
+    void shuffle_apple();
+
+    std::size_t get_free_cell_count() const { return width * height - occupied; }
+
+    // Chunks currently holding at least one body cell.
+    std::size_t get_allocated_chunk_count() const { return chunks.size(); }
+
+    const position_type &get_apple_position() const { return apple; }
+
+    void place_apple(position_type position) {
+        hash ^= zobrist_key(ZobristFeature::APPLE, to_cell(apple)) ^ zobrist_key(ZobristFeature::APPLE, to_cell(position));
+        apple = position;
+    }
+
+    std::uint64_t get_hash() const { return hash; }
+
+    std::size_t to_cell(position_type position) const { return position.row * width + position.col; }
+
+    // Same board, apple and RNG state, whatever order the chunks were
+    // allocated in.
+    bool operator==(const BasicChunkedSnakeGrid &other) const;
+
+private:
+    static constexpr std::uint32_t NO_CHUNK = ~std::uint32_t{0};
+
+    struct Chunk {
+        std::array<std::uint64_t, CHUNK_SIZE> rows{};
+        std::uint32_t count = 0;
+    };
+
+    std::size_t chunk_of(position_type position) const {
+        return position.row / CHUNK_SIZE * chunk_columns + position.col / CHUNK_SIZE;
+    }
+
+    position_type to_position(std::size_t cell) const {
+        return {static_cast<Coord>(cell / width), static_cast<Coord>(cell % width)};
+    }
+
+    // Frees an empty chunk by moving the last chunk into its place.
+    void release_chunk(std::uint32_t index);
+
+    std::size_t chunk_rows(std::size_t chunk) const;
+    std::size_t chunk_cols(std::size_t chunk) const;
+    position_type nth_free_cell(std::size_t k) const;
+
+    std::size_t width;
+    std::size_t height;
+    std::size_t chunk_columns;
+    std::vector<std::uint32_t> chunk_table;
+    // Allocated chunks, densely packed, and the chunk table entry of each.
+    std::vector<Chunk> chunks;
+    std::vector<std::uint32_t> chunk_owners;
+    std::size_t occupied = 0;
+    position_type apple;
+    std::uint64_t hash;
+    Xoshiro256 rng;
+};
+
+using ChunkedSnakeGrid = BasicChunkedSnakeGrid<std::uint32_t>;
+
+extern template class BasicChunkedSnakeGrid<std::uint16_t>;
+extern template class BasicChunkedSnakeGrid<std::uint32_t>;
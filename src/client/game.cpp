@@ -8,7 +8,7 @@
 #include <raylib.h>
 
 void GameContext::update_and_render(App &app) {
-    const double elapsed = timer.elapsed().count();
+    const double elapsed = timer.elapsed<std::chrono::duration<double>>().count();
     update(elapsed);
     poll_events(elapsed);
 
@@ -76,14 +76,19 @@ void GameContext::render(const double time, App &app) {
 }
 
 void SinglePlayerGame::update(const double time) {
-    player.update(grid, time);
+    clock.advance_to(time, [this](std::uint64_t tick) {
+        apply_inputs(*inputs, player.snake, tick);
+        player.update(grid);
+    });
 }
 
 void SinglePlayerGame::poll_events(double) {
-    if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D)) player.snake.push_direction(Direction::RIGHT);
-    if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) player.snake.push_direction(Direction::DOWN);
-    if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) player.snake.push_direction(Direction::LEFT);
-    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) player.snake.push_direction(Direction::UP);
+    // Stamped for the next tick to run, which is the one they belong to.
+    const std::uint64_t tick = clock.get_tick();
+    if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D)) inputs->try_push({tick, Direction::RIGHT});
+    if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) inputs->try_push({tick, Direction::DOWN});
+    if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) inputs->try_push({tick, Direction::LEFT});
+    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) inputs->try_push({tick, Direction::UP});
 }
 
 static inline Color CHECKER_COLOR1 = ColorFromHSV(110, 0.6, 0.9);
@@ -107,5 +112,5 @@ void SinglePlayerGame::render(const double time) {
     render_checker_board(offset, grid.get_width(), grid.get_height(), square_size, CHECKER_COLOR1, CHECKER_COLOR2);
     render_fruit(grid.get_apple_position(), offset, square_size, time);
 
-    player.render(grid, offset, square_size, time);
+    player.render(grid, offset, square_size, clock.get_alpha());
 }
@@ -1,32 +1,44 @@
 #pragma once
 
+#include "../input_queue.hpp"
 #include "../snake.hpp"
+#include "../tick_clock.hpp"
 #include "../timer.hpp"
 
 #include "visuals.hpp"
 
+#include <memory>
+#include <random>
+
 struct App;
 
 struct SinglePlayerSettings {
     std::size_t width = 10;
     std::size_t height = 9;
+    TickRate tick_rate{};
     SnakeSkin skin{};
 };
 
 class SinglePlayerGame {
 public:
     explicit SinglePlayerGame(const SinglePlayerSettings &settings)
-        : grid(settings.width, settings.height), player(grid, Position{grid.get_height() / 2, 4}, settings.skin) {}
+        : grid(settings.width, settings.height, std::random_device{}()), player(grid, Position{static_cast<std::uint16_t>(grid.get_height() / 2), 4}, settings.skin), clock(settings.tick_rate) {}
 
     void update(double time);
     void poll_events(double time);
     void render(double time);
 
     const SnakeGrid &get_grid() const { return grid; }
+    TickClock &get_clock() { return clock; }
+    // Where input and network threads send the player's turns.
+    InputQueue &get_inputs() { return *inputs; }
 
 private:
     SnakeGrid grid;
     VisualSnake player;
+    TickClock clock;
+    // Boxed because the atomics pin it in memory while the game is moved around.
+    std::unique_ptr<InputQueue> inputs = std::make_unique<InputQueue>();
 };
 
 struct GameContext {
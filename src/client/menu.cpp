@@ -45,6 +45,7 @@ void SinglePlayerMenu::render(MenuState &menu_state, App &app) {
 
     const Rectangle width_slider {PADDING, y, ITEM_WIDTH, ITEM_HEIGHT}; y += ITEM_HEIGHT + GAP;
     const Rectangle height_slider{PADDING, y, ITEM_WIDTH, ITEM_HEIGHT}; y += ITEM_HEIGHT + GAP;
+    const Rectangle speed_spinner{PADDING, y, ITEM_WIDTH, ITEM_HEIGHT}; y += ITEM_HEIGHT + GAP;
     const Rectangle color_slider {PADDING, y, ITEM_WIDTH, ITEM_HEIGHT}; y += ITEM_HEIGHT + GAP;
 
     constexpr static std::array<Position, 4> snake_body{Position{0, 3}, Position{0, 2}, Position{0, 1}, Position{0, 0}};
@@ -70,12 +71,16 @@ void SinglePlayerMenu::render(MenuState &menu_state, App &app) {
     settings.width = static_cast<std::size_t>(width);
     settings.height = static_cast<std::size_t>(height);
 
+    int speed = static_cast<int>(settings.tick_rate.ticks_per_second);
+    GuiSpinner(relative(content_rect, speed_spinner), "Speed", &speed, 4, 60, false);
+    settings.tick_rate.ticks_per_second = speed;
+
     GuiSlider(relative(content_rect, color_slider), "Color", nullptr, &settings.skin.body_hue, 0, 360);
 
     {
         const Rectangle relative_rect = relative(content_rect, snake_rect);
         const Vector2 offset = {relative_rect.x, relative_rect.y};
-        render_snake(snake_body, Direction::RIGHT, snake_body.back(), settings.skin, offset, snake_scale);
+        render_snake(BodyView{snake_body}, Direction::RIGHT, snake_body.back(), settings.skin, offset, snake_scale);
     }
 
     if (GuiButton(relative(content_rect, start_button), "Start") || IsKeyPressed(KEY_SPACE)) {
@@ -75,7 +75,7 @@ inline Vector2 calculate_screen_pos(Vector2 offset, float square_size, const Pos
     return offset + Vector2{static_cast<float>(pos.col), static_cast<float>(pos.row)} * square_size + Vector2{square_size / 2, square_size / 2};
 }
 
-void render_snake_body(std::span<const Position> body, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time) {
+void render_snake_body(BodyView body, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time) {
     auto screen_pos = std::bind_front(calculate_screen_pos, offset, square_size);
 
 //    for (const auto &[pos_before, pos_now, pos_after] : body | std::views::adjacent<3>) {
@@ -93,7 +93,7 @@ void render_snake_body(std::span<const Position> body, const SnakeSkin &skin, Ve
     }
 }
 
-void render_snake_head(std::span<const Position> body, Direction next_direction, const SnakeSkin &skin, std::optional<Position> fruit_target, Vector2 offset, float square_size, double interpolate_time) {
+void render_snake_head(BodyView body, Direction next_direction, const SnakeSkin &skin, std::optional<Position> fruit_target, Vector2 offset, float square_size, double interpolate_time) {
     if (body.size() < 2) return;
 
     auto screen_pos = std::bind_front(calculate_screen_pos, offset, square_size);
@@ -153,7 +153,7 @@ void render_snake_head(std::span<const Position> body, Direction next_direction,
     }
 }
 
-void render_snake_tail(std::span<const Position> body, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time) {
+void render_snake_tail(BodyView body, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time) {
     if (body.size() < 2) return;
 
     auto screen_pos = std::bind_front(calculate_screen_pos, offset, square_size);
@@ -162,8 +162,8 @@ void render_snake_tail(std::span<const Position> body, const Position &prev_tail
     const float body_size = skin.calculate_body_size(tail_index, square_size);
     const Color body_color = skin.calculate_body_color(tail_index, static_cast<float>(interpolate_time));
 
-    const Position &tail = body.end()[-1];
-    const Position &after_tail = body.end()[-2];
+    const Position &tail = body[tail_index];
+    const Position &after_tail = body[tail_index - 1];
     const Vector2 center = screen_pos(tail);
     const Vector2 out_pos = (screen_pos(after_tail) + center) / 2;
 
@@ -179,16 +179,13 @@ void render_snake_tail(std::span<const Position> body, const Position &prev_tail
     }
 }
 
-void VisualSnake::render(const SnakeGrid &grid, Vector2 offset, float square_size, double time) const {
-    const double interpolate_time = snake.has_state<AliveSnake>() ? std::fmod(time - last_update, SPT) / SPT : 0;
+void VisualSnake::render(const SnakeGrid &grid, Vector2 offset, float square_size, double alpha) const {
+    const double interpolate_time = snake.has_state<AliveSnake>() ? alpha : 0;
 
     render_snake(snake.get_body(), snake.get_next_direction(), snake.get_previous_tail_position(), skin, offset, square_size, grid.get_apple_position(), interpolate_time);
 }
 
-void VisualSnake::update(SnakeGrid &grid, double time) {
-    if (time - last_update < SPT) return;
-
-    last_update = time;
+void VisualSnake::update(SnakeGrid &grid) {
     snake.update(grid);
 }
 
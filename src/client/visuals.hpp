@@ -3,7 +3,6 @@
 #include "../snake.hpp"
 
 #include <cstddef>
-#include <span>
 #include <optional>
 
 #include "raylib.h"
@@ -24,27 +23,27 @@ class VisualSnake {
 public:
     VisualSnake(SnakeGrid &grid, const Position &position, SnakeSkin skin) : snake(grid, position), skin(std::move(skin)) {}
 
-    void render(const SnakeGrid &grid, Vector2 offset, float square_size, double time) const;
+    // alpha is how far the game is towards the next tick, from the TickClock.
+    void render(const SnakeGrid &grid, Vector2 offset, float square_size, double alpha) const;
 
-    void update(SnakeGrid &grid, double time);
+    void update(SnakeGrid &grid);
 
     Snake snake;
 private:
     SnakeSkin skin;
-    double last_update = 0;
 };
 
 void render_checker_board(Vector2 offset, std::size_t width, std::size_t height, float square_size, Color color1, Color color2);
 
 void render_fruit(const Position &fruit, Vector2 offset, float square_size, double time);
 
-void render_snake_body(std::span<const Position> body, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time);
+void render_snake_body(BodyView body, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time);
 
-void render_snake_head(std::span<const Position> body, Direction next_direction, const SnakeSkin &skin, std::optional<Position> fruit_target, Vector2 offset, float square_size, double interpolate_time);
+void render_snake_head(BodyView body, Direction next_direction, const SnakeSkin &skin, std::optional<Position> fruit_target, Vector2 offset, float square_size, double interpolate_time);
 
-void render_snake_tail(std::span<const Position> body, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time);
+void render_snake_tail(BodyView body, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, double interpolate_time);
 
-inline void render_snake(std::span<const Position> body, Direction next_direction, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, std::optional<Position> fruit_target = std::nullopt, double interpolate_time = 0) {
+inline void render_snake(BodyView body, Direction next_direction, const Position &prev_tail_position, const SnakeSkin &skin, Vector2 offset, float square_size, std::optional<Position> fruit_target = std::nullopt, double interpolate_time = 0) {
     render_snake_tail(body, prev_tail_position, skin, offset, square_size, interpolate_time);
     render_snake_body(body, skin, offset, square_size, interpolate_time);
     render_snake_head(body, next_direction, skin, fruit_target, offset, square_size, interpolate_time);
@@ -0,0 +1,144 @@
+#include "flood_fill.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Bits [offset, offset + 64) of a packed bit string; missing bits read as zero.
+std::uint64_t extract_bits(std::span<const std::uint64_t> words, std::size_t offset) {
+    const std::size_t word = offset / WORD_BITS;
+    const std::size_t shift = offset % WORD_BITS;
+    std::uint64_t bits = words[word] >> shift;
+    if (shift != 0 && word + 1 < words.size()) bits |= words[word + 1] << (WORD_BITS - shift);
+    return bits;
+}
+
+// Spreads seeds up and down through runs of passable bits within one word.
+std::uint64_t fill_word(std::uint64_t seeds, std::uint64_t passable) {
+    std::uint64_t up = seeds & passable;
+    std::uint64_t down = up;
+    std::uint64_t up_mask = passable;
+    std::uint64_t down_mask = passable;
+    for (unsigned shift = 1; shift < WORD_BITS; shift *= 2) {
+        up |= up_mask & (up << shift);
+        up_mask &= up_mask << shift;
+        down |= down_mask & (down >> shift);
+        down_mask &= down_mask >> shift;
+    }
+    return up | down;
+}
+
+#if defined(__AVX2__)
+// fill_word on four words at once.
+__m256i fill_words(__m256i seeds, __m256i passable) {
+    __m256i up = _mm256_and_si256(seeds, passable);
+    __m256i down = up;
+    __m256i up_mask = passable;
+    __m256i down_mask = passable;
+    for (int shift = 1; shift < static_cast<int>(WORD_BITS); shift *= 2) {
+        up = _mm256_or_si256(up, _mm256_and_si256(up_mask, _mm256_slli_epi64(up, shift)));
+        up_mask = _mm256_and_si256(up_mask, _mm256_slli_epi64(up_mask, shift));
+        down = _mm256_or_si256(down, _mm256_and_si256(down_mask, _mm256_srli_epi64(down, shift)));
+        down_mask = _mm256_and_si256(down_mask, _mm256_srli_epi64(down_mask, shift));
+    }
+    return _mm256_or_si256(up, down);
+}
+#endif
+
+constexpr std::uint64_t TOP_BIT = std::uint64_t{1} << (WORD_BITS - 1);
+
+} // namespace
+
+void RowBitboard::assign_free_cells(std::span<const std::uint64_t> occupancy) {
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t i = 0; i < words_per_row; ++i) {
+            const std::size_t bits = std::min(WORD_BITS, width - i * WORD_BITS);
+            const std::uint64_t mask = bits == WORD_BITS ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+            words[row * words_per_row + i] = ~extract_bits(occupancy, row * width + i * WORD_BITS) & mask;
+        }
+    }
+}
+
+std::size_t RowBitboard::count() const {
+    std::size_t total = 0;
+    for (const std::uint64_t word : words) total += static_cast<std::size_t>(std::popcount(word));
+    return total;
+}
+
+void RowBitboard::clear() {
+    std::ranges::fill(words, 0);
+}
+
+std::size_t FloodFill::fill(const RowBitboard &passable, std::size_t row, std::size_t col) {
+    if (region.get_width() != passable.get_width() || region.get_height() != passable.get_height()) {
+        region = RowBitboard(passable.get_width(), passable.get_height());
+    } else {
+        region.clear();
+    }
+    if (!passable.test(row, col)) return 0;
+
+    region.set(row, col, true);
+    fill_row(region.get_row(row), passable.get_row(row));
+
+    const std::size_t height = passable.get_height();
+    const auto spread = [&](std::size_t to, std::size_t from) {
+        return spread_row(region.get_row(to), region.get_row(from), passable.get_row(to));
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t r = 1; r < height; ++r) changed |= spread(r, r - 1);
+        for (std::size_t r = height - 1; r-- > 0;) changed |= spread(r, r + 1);
+    }
+    return region.count();
+}
+
+bool FloodFill::spread_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> neighbour_row, std::span<const std::uint64_t> passable_row) {
+    // Only words that gain seeds are refilled, so long thin regions cost a
+    // word per row and sweep rather than a whole row.
+    bool grew = false;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= row.size(); i += 4) {
+        const __m256i cells = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row.data() + i));
+        const __m256i open = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(passable_row.data() + i));
+        const __m256i neighbours = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(neighbour_row.data() + i));
+        const __m256i seeds = _mm256_andnot_si256(cells, _mm256_and_si256(neighbours, open));
+        if (_mm256_testz_si256(seeds, seeds)) continue;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(row.data() + i), fill_words(_mm256_or_si256(cells, seeds), open));
+        grew = true;
+    }
+#endif
+    for (; i < row.size(); ++i) {
+        const std::uint64_t seeds = neighbour_row[i] & passable_row[i] & ~row[i];
+        if (seeds == 0) continue;
+        row[i] = fill_word(row[i] | seeds, passable_row[i]);
+        grew = true;
+    }
+    if (grew) carry_row(row, passable_row);
+    return grew;
+}
+
+void FloodFill::fill_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> passable_row) {
+    for (std::size_t i = 0; i < row.size(); ++i) row[i] = fill_word(row[i], passable_row[i]);
+    carry_row(row, passable_row);
+}
+
+void FloodFill::carry_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> passable_row) {
+    // Carry runs across word boundaries: rightwards in one pass, then leftwards.
+    for (std::size_t i = 0; i + 1 < row.size(); ++i) {
+        if ((row[i] & TOP_BIT) && (passable_row[i + 1] & ~row[i + 1] & 1)) {
+            row[i + 1] = fill_word(row[i + 1] | 1, passable_row[i + 1]);
+        }
+    }
+    for (std::size_t i = row.size() - 1; i > 0; --i) {
+        if ((row[i] & 1) && (passable_row[i - 1] & ~row[i - 1] & TOP_BIT)) {
+            row[i - 1] = fill_word(row[i - 1] | TOP_BIT, passable_row[i - 1]);
+        }
+    }
+}
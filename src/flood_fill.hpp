@@ -0,0 +1,80 @@
+#pragma once
+
+#include "bitboard.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Board mask with every row starting on a fresh word: bit col % 64 of word
+// row * words_per_row + col / 64. Bits past the width are always clear, so
+// shifts along a row never leak into the next one.
+class RowBitboard {
+public:
+    RowBitboard() = default;
+    RowBitboard(std::size_t width, std::size_t height)
+        : width(width), height(height), words_per_row(word_count(width)), words(words_per_row * height) {}
+
+    // The free cells of a grid, from its row-major occupancy (SnakeGrid::get_occupancy).
+    void assign_free_cells(std::span<const std::uint64_t> occupancy);
+
+    std::size_t get_width() const { return width; }
+    std::size_t get_height() const { return height; }
+    std::size_t get_words_per_row() const { return words_per_row; }
+
+    bool test(std::size_t row, std::size_t col) const {
+        return (words[row * words_per_row + col / WORD_BITS] >> (col % WORD_BITS)) & 1;
+    }
+    void set(std::size_t row, std::size_t col, bool value) {
+        std::uint64_t &word = words[row * words_per_row + col / WORD_BITS];
+        const std::uint64_t bit = std::uint64_t{1} << (col % WORD_BITS);
+        word = value ? word | bit : word & ~bit;
+    }
+
+    std::size_t count() const;
+    void clear();
+
+    std::span<std::uint64_t> get_row(std::size_t row) { return std::span{words}.subspan(row * words_per_row, words_per_row); }
+    std::span<const std::uint64_t> get_row(std::size_t row) const { return std::span{words}.subspan(row * words_per_row, words_per_row); }
+    std::span<const std::uint64_t> get_words() const { return words; }
+
+    bool operator==(const RowBitboard &) const = default;
+
+private:
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::size_t words_per_row = 0;
+    std::vector<std::uint64_t> words;
+};
+
+// Reachability by flood fill over whole words instead of cell by cell.
+//
+// Each row is filled sideways with a shift/and/or cascade (log2(64) steps per
+// word, four words at a time when built with SNAKE_AVX2) plus a carry pass
+// across its words.
+// Rows then seed their neighbours above and below, refilling only the words
+// that gained cells, in down and up sweeps until nothing changes. Sweeps
+// needed grow with how often the region winds up and down, not with its
+// size. The region buffer is reused between calls.
+class FloodFill {
+public:
+    // Cells reachable from (row, col) through passable ones, counting the start;
+    // zero if the start itself is not passable.
+    std::size_t fill(const RowBitboard &passable, std::size_t row, std::size_t col);
+
+    // The cells reached by the last fill.
+    const RowBitboard &get_region() const { return region; }
+
+private:
+    // Grows a row's cells sideways as far as its passable cells allow.
+    static void fill_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> passable_row);
+    // Seeds row from the region cells of the row above or below and fills
+    // the words that gained any; returns whether the row grew.
+    static bool spread_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> neighbour_row,
+                           std::span<const std::uint64_t> passable_row);
+    // Continues runs that reach a word's edge into the next word.
+    static void carry_row(std::span<std::uint64_t> row, std::span<const std::uint64_t> passable_row);
+
+    RowBitboard region;
+};
@@ -0,0 +1,4 @@
+#include "grid.hpp"
+
+template class BasicSnakeGrid<DynamicExtent<std::uint16_t>>;
+template class BasicSnakeGrid<DynamicExtent<std::uint32_t>>;
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "bitboard.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+template <std::unsigned_integral Coord>
+struct BasicPosition {
+    using coord_type = Coord;
+
+    Coord row;
+    Coord col;
+
+    bool operator==(const BasicPosition &other) const {
+        return row == other.row && col == other.col;
+    }
+};
+
+// 4 bytes per position; fits boards of up to 65535x65535.
+using Position = BasicPosition<std::uint16_t>;
+
+enum class Direction {
+    RIGHT,
+    DOWN,
+    LEFT,
+    UP,
+};
+
+// The neighbouring cell in a direction, or nothing past the board's edge.
+template <std::unsigned_integral Coord>
+std::optional<BasicPosition<Coord>> step_position(BasicPosition<Coord> head, Direction direction, std::size_t width, std::size_t height) {
+    switch (direction) {
+    case Direction::RIGHT:
+        if (head.col + std::size_t{1} < width) {
+            return BasicPosition<Coord>{head.row, static_cast<Coord>(head.col + 1)};
+        }
+        break;
+    case Direction::DOWN:
+        if (head.row + std::size_t{1} < height) {
+            return BasicPosition<Coord>{static_cast<Coord>(head.row + 1), head.col};
+        }
+        break;
+    case Direction::LEFT:
+        if (head.col > 0) {
+            return BasicPosition<Coord>{head.row, static_cast<Coord>(head.col - 1)};
+        }
+        break;
+    case Direction::UP:
+        if (head.row > 0) {
+            return BasicPosition<Coord>{static_cast<Coord>(head.row - 1), head.col};
+        }
+        break;
+    }
+    return std::nullopt;
+}
+
+enum class ZobristFeature : std::uint64_t {
+    BODY,
+    APPLE,
+    HEAD,
+    HEADING,
+};
+
+// Zobrist key of a feature at a cell (or, for HEADING, of a direction). Mixed on
+// the fly instead of looked up, so huge boards need no key table.
+constexpr std::uint64_t zobrist_key(ZobristFeature feature, std::uint64_t cell) {
+    std::uint64_t state = cell * 4 + static_cast<std::uint64_t>(feature);
+    return splitmix64(state);
+}
+
+// Board size chosen at runtime, storage on the heap.
+template <std::unsigned_integral Coord = std::uint16_t>
+struct DynamicExtent {
+    template <typename T, std::size_t>
+    using array = std::vector<T>;
+
+    using coord_type = Coord;
+    using cell_type = std::uint32_t;
+
+    static constexpr std::size_t static_cells = 0;
+
+    template <typename T, std::size_t N>
+    static array<T, N> make_array(std::size_t size) { return array<T, N>(size); }
+
+    bool operator==(const DynamicExtent &) const = default;
+
+    std::size_t width;
+    std::size_t height;
+};
+
+// Board size fixed at compile time, so bounds and cell indexing fold into
+// constants and the storage is inline.
+template <std::size_t Width, std::size_t Height>
+struct StaticExtent {
+    template <typename T, std::size_t N>
+    using array = std::array<T, N>;
+
+    using coord_type = std::conditional_t<(Width <= 0x100 && Height <= 0x100), std::uint8_t,
+                                          std::conditional_t<(Width <= 0x10000 && Height <= 0x10000), std::uint16_t, std::uint32_t>>;
+    using cell_type = std::conditional_t<Width * Height <= 0x10000, std::uint16_t, std::uint32_t>;
+
+    static constexpr std::size_t static_cells = Width * Height;
+
+    template <typename T, std::size_t N>
+    static array<T, N> make_array(std::size_t) { return {}; }
+
+    bool operator==(const StaticExtent &) const = default;
+
+    static constexpr std::size_t width = Width;
+    static constexpr std::size_t height = Height;
+};
+
+template <typename Extent>
+class BasicSnakeGrid {
+    using cell_type = typename Extent::cell_type;
+
+    template <typename T, std::size_t N>
+    using array = typename Extent::template array<T, N>;
+
+public:
+    using coord_type = typename Extent::coord_type;
+    using position_type = BasicPosition<coord_type>;
+
+    BasicSnakeGrid(Extent extent, std::uint64_t seed);
+
+    BasicSnakeGrid(std::size_t width, std::size_t height, std::uint64_t seed)
+        requires (Extent::static_cells == 0)
+        : BasicSnakeGrid(Extent{width, height}, seed) {}
+
+    explicit BasicSnakeGrid(std::uint64_t seed)
+        requires (Extent::static_cells != 0)
+        : BasicSnakeGrid(Extent{}, seed) {}
+
+    void set_snake_body(position_type position, bool value);
+
+    bool is_snake_body(position_type position) const {
+        const std::size_t cell = to_cell(position);
+        return (occupancy[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1;
+    }
+
+    std::optional<position_type> move_head(position_type head, Direction direction) const {
+        return step_position(head, direction, extent.width, extent.height);
+    }
+
+    std::size_t get_width() const { return extent.width; }
+    std::size_t get_height() const { return extent.height; }
+
+    void shuffle_apple();
+    // Restarts the apple RNG, e.g. so a planner's copy of the game cannot
+    // foresee where the real game's apples will appear.
+    void reseed(std::uint64_t seed) { rng = Xoshiro256(seed); }
+
+    std::size_t get_free_cell_count() const { return free_count; }
+
+    // The k-th free cell in row-major order.
+    position_type get_nth_free_cell(std::size_t k) const { return to_position(select_clear_bit(occupancy, k)); }
+
+    // Row-major occupancy, one bit per cell. Padding bits past the last cell are set.
+    std::span<const std::uint64_t> get_occupancy() const { return occupancy; }
+
+    const position_type &get_apple_position() const { return apple; }
+
+    // Puts the apple on a chosen free cell, e.g. when replaying a recorded game.
+    void place_apple(position_type position) {
+        hash ^= zobrist_key(ZobristFeature::APPLE, to_cell(apple)) ^ zobrist_key(ZobristFeature::APPLE, to_cell(position));
+        apple = position;
+    }
+
+    // Zobrist hash of the occupancy and the apple, kept up to date in O(1) per change.
+    std::uint64_t get_hash() const { return hash; }
+
+    // Cell index used for Zobrist keys and occupancy bits.
+    std::size_t to_cell(position_type position) const { return position.row * extent.width + position.col; }
+
+    // Same board, apple and RNG state. The free-cell index is compared as a
+    // set: its order and the slots of occupied cells depend on the order in
+    // which cells were freed, not on the board.
+    bool operator==(const BasicSnakeGrid &other) const;
+
+private:
+    position_type to_position(std::size_t cell) const {
+        return {static_cast<coord_type>(cell / extent.width), static_cast<coord_type>(cell % extent.width)};
+    }
+
+    [[no_unique_address]] Extent extent;
+    array<std::uint64_t, word_count(Extent::static_cells)> occupancy;
+    // Dense list of the free cells, plus each cell's slot in that list, so
+    // an apple can be placed with a single random index.
+    array<cell_type, Extent::static_cells> free_cells;
+    array<cell_type, Extent::static_cells> free_slot;
+    std::size_t free_count;
+    position_type apple;
+    std::uint64_t hash;
+    Xoshiro256 rng;
+};
+
+using SnakeGrid = BasicSnakeGrid<DynamicExtent<>>;
+
+template <std::size_t Width, std::size_t Height>
+using FixedSnakeGrid = BasicSnakeGrid<StaticExtent<Width, Height>>;
+
+// What Snake needs from a grid; satisfied by every BasicSnakeGrid.
+template <typename T>
+concept GridLike = requires(T &grid, const T &const_grid, typename T::position_type position, Direction direction) {
+    grid.set_snake_body(position, true);
+    grid.shuffle_apple();
+    { const_grid.get_free_cell_count() } -> std::convertible_to<std::size_t>;
+    { const_grid.is_snake_body(position) } -> std::same_as<bool>;
+    { const_grid.move_head(position, direction) } -> std::same_as<std::optional<typename T::position_type>>;
+    { const_grid.get_apple_position() } -> std::convertible_to<typename T::position_type>;
+};
+
+template <typename Extent>
+BasicSnakeGrid<Extent>::BasicSnakeGrid(Extent extent, std::uint64_t seed)
+    : extent(extent),
+      occupancy(Extent::template make_array<std::uint64_t, word_count(Extent::static_cells)>(word_count(extent.width * extent.height))),
+      free_cells(Extent::template make_array<cell_type, Extent::static_cells>(extent.width * extent.height)),
+      free_slot(Extent::template make_array<cell_type, Extent::static_cells>(extent.width * extent.height)),
+      free_count(extent.width * extent.height),
+      apple{static_cast<coord_type>(extent.height / 2), static_cast<coord_type>(extent.width - 3)},
+      hash(zobrist_key(ZobristFeature::APPLE, to_cell(apple))),
+      rng(seed) {
+    std::ranges::fill(occupancy, 0);
+    for (std::size_t i = 0; i < free_count; ++i) {
+        free_cells[i] = static_cast<cell_type>(i);
+        free_slot[i] = static_cast<cell_type>(i);
+    }
+    if (const std::size_t used_bits = free_count % WORD_BITS) {
+        occupancy.back() = ~std::uint64_t{0} << used_bits;
+    }
+}
+
+template <typename Extent>
+void BasicSnakeGrid<Extent>::set_snake_body(position_type position, bool value) {
+    const std::size_t cell = to_cell(position);
+    const std::uint64_t mask = std::uint64_t{1} << (cell % WORD_BITS);
+    std::uint64_t &word = occupancy[cell / WORD_BITS];
+    if (((word & mask) != 0) == value) return;
+    word ^= mask;
+    hash ^= zobrist_key(ZobristFeature::BODY, cell);
+
+    if (value) {
+        const cell_type slot = free_slot[cell];
+        const cell_type last = free_cells[--free_count];
+        free_cells[slot] = last;
+        free_slot[last] = slot;
+    } else {
+        free_slot[cell] = static_cast<cell_type>(free_count);
+        free_cells[free_count++] = static_cast<cell_type>(cell);
+    }
+}
+
+template <typename Extent>
+bool BasicSnakeGrid<Extent>::operator==(const BasicSnakeGrid &other) const {
+    if (!(extent == other.extent) || free_count != other.free_count || !(apple == other.apple) || !(rng == other.rng)) {
+        return false;
+    }
+    if (!std::ranges::equal(occupancy, other.occupancy)) return false;
+
+    // Both indexes hold free_count distinct cells, so they are the same set
+    // if every cell in this one is free in the other.
+    for (std::size_t i = 0; i < free_count; ++i) {
+        const std::size_t cell = free_cells[i];
+        if ((other.occupancy[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1) return false;
+    }
+    return true;
+}
+
+template <typename Extent>
+void BasicSnakeGrid<Extent>::shuffle_apple() {
+    if (free_count == 0) return;
+
+    place_apple(to_position(free_cells[random_below(rng, free_count)]));
+}
+
+extern template class BasicSnakeGrid<DynamicExtent<std::uint16_t>>;
+extern template class BasicSnakeGrid<DynamicExtent<std::uint32_t>>;
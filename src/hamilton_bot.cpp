@@ -0,0 +1,37 @@
+#include "hamilton_bot.hpp"
+
+#include <algorithm>
+
+void HamiltonBot::build(std::size_t board_width, std::size_t board_height) {
+    if (board_width == width && board_height == height) return;
+    width = board_width;
+    height = board_height;
+    cycle.clear();
+    order.assign(width * height, 0);
+
+    const auto add = [this](std::size_t row, std::size_t col) { cycle.push_back(static_cast<std::uint32_t>(row * width + col)); };
+    if (width < 2 || height < 2) {
+        return;
+    } else if (height % 2 == 0) {
+        // Snake through the rows over columns 1.., then back up column 0.
+        for (std::size_t row = 0; row < height; ++row) {
+            for (std::size_t i = 1; i < width; ++i) add(row, row % 2 == 0 ? i : width - i);
+        }
+        for (std::size_t row = height; row-- > 0;) add(row, 0);
+    } else if (width % 2 == 0) {
+        // The same, transposed: down and up the columns, then back along row 0.
+        for (std::size_t col = 0; col < width; ++col) {
+            for (std::size_t i = 1; i < height; ++i) add(col % 2 == 0 ? i : height - i, col);
+        }
+        for (std::size_t col = width; col-- > 0;) add(0, col);
+    } else {
+        return;
+    }
+
+    for (std::size_t index = 0; index < cycle.size(); ++index) order[cycle[index]] = static_cast<std::uint32_t>(index);
+}
+
+void HamiltonBot::reverse() {
+    std::ranges::reverse(cycle);
+    for (std::size_t index = 0; index < cycle.size(); ++index) order[cycle[index]] = static_cast<std::uint32_t>(index);
+}
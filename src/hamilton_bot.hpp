@@ -0,0 +1,109 @@
+#pragma once
+
+#include "snake.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Bot that can fill the board. It follows a Hamiltonian cycle through every
+// cell and cuts ahead along it towards the apple when that is provably safe.
+//
+// Once the body lies in cycle order from tail to head, every cell ahead of
+// the head on the cycle, up to the tail, is free. A move that lands strictly
+// before the tail in cycle order keeps that invariant, so the snake can never
+// trap itself; moves also never jump past the apple. Each decision looks at
+// the four neighbours through the precomputed cycle index table, so it is
+// O(1) regardless of length.
+//
+// A cycle needs an even number of rows or columns; on odd-by-odd boards (and
+// boards one cell wide) the bot has no cycle and gives no input. Call
+// start_game before every game, as run_games does.
+class HamiltonBot {
+public:
+    template <GridLike Grid>
+    void start_game(const Grid &grid, std::uint64_t) {
+        build(grid.get_width(), grid.get_height());
+        settled = false;
+    }
+
+    template <GridLike Grid>
+    std::optional<Direction> operator()(const BasicSnake<typename Grid::coord_type> &snake, const Grid &grid);
+
+    bool has_cycle() const { return !cycle.empty(); }
+
+private:
+    // Lays out the cycle for a board, unless it is already built for that size.
+    void build(std::size_t board_width, std::size_t board_height);
+    // Runs the cycle the other way round.
+    void reverse();
+
+    template <typename Position>
+    std::uint32_t cell_of(const Position &position) const {
+        return static_cast<std::uint32_t>(position.row * width + position.col);
+    }
+    template <typename Position>
+    std::uint32_t index_of(const Position &position) const { return order[cell_of(position)]; }
+
+    // Steps forward along the cycle from one index to another.
+    std::size_t distance(std::size_t from, std::size_t to) const {
+        return to >= from ? to - from : to + cycle.size() - from;
+    }
+
+    std::size_t width = 0;
+    std::size_t height = 0;
+    // Cycle index of each cell, and the cell (row * width + col) at each index.
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> cycle;
+    // Whether the body has been seen in cycle order; until then the bot only
+    // follows the cycle where it is free.
+    bool settled = false;
+};
+
+template <GridLike Grid>
+std::optional<Direction> HamiltonBot::operator()(const BasicSnake<typename Grid::coord_type> &snake, const Grid &grid) {
+    using position_type = typename Grid::position_type;
+
+    build(grid.get_width(), grid.get_height());
+    if (!has_cycle()) return std::nullopt;
+
+    const auto body = snake.get_body();
+    const position_type head = body.front();
+    const position_type tail = body.back();
+    const std::size_t cycle_size = cycle.size();
+    std::size_t head_index = index_of(head);
+
+    if (!settled) {
+        // Start the way the snake faces rather than back into its own neck.
+        if (body.size() > 1 && cycle[(head_index + 1) % cycle_size] == cell_of(body[1])) {
+            reverse();
+            head_index = index_of(head);
+        }
+        // In cycle order when the forward steps from tail to head wrap around less than once.
+        std::size_t covered = 0;
+        for (std::size_t i = 0; i + 1 < body.size(); ++i) covered += distance(index_of(body[i + 1]), index_of(body[i]));
+        settled = covered < cycle_size;
+    }
+
+    const std::size_t tail_distance = distance(head_index, index_of(tail));
+    const std::size_t apple_distance = distance(head_index, index_of(grid.get_apple_position()));
+
+    std::optional<Direction> best;
+    std::size_t best_distance = 0;
+    for (const Direction direction : {Direction::RIGHT, Direction::DOWN, Direction::LEFT, Direction::UP}) {
+        const std::optional<position_type> next = grid.move_head(head, direction);
+        if (!next || (grid.is_snake_body(*next) && *next != tail)) continue;
+
+        const std::size_t next_distance = distance(head_index, index_of(*next));
+        if (!settled) {
+            // Follow the cycle where it is free and step aside where it is not.
+            if (next_distance == 1) return direction;
+            if (!best) best = direction;
+        } else if (next_distance > best_distance && next_distance <= apple_distance &&
+                   (next_distance == 1 || next_distance < tail_distance)) {
+            best = direction;
+            best_distance = next_distance;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "snake.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded lock-free ring for exactly one producer thread and one consumer
+// thread. Each index is written by one side only, so a release store and an
+// acquire load per operation are all the synchronisation needed.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    // Producer side. Returns false, dropping value, if the ring is full.
+    bool try_push(const T &value) {
+        const std::size_t back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) == Capacity) return false;
+        slots[back & (Capacity - 1)] = value;
+        tail.store(back + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: the oldest value, or nullptr if the ring is empty. It
+    // stays valid until pop.
+    const T *front() const {
+        const std::size_t front_index = head.load(std::memory_order_relaxed);
+        if (front_index == tail.load(std::memory_order_acquire)) return nullptr;
+        return &slots[front_index & (Capacity - 1)];
+    }
+
+    void pop() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::array<T, Capacity> slots{};
+};
+
+// A turn and the tick it is meant for.
+struct InputCommand {
+    std::uint64_t tick = 0;
+    Direction direction = Direction::RIGHT;
+};
+
+using InputQueue = SpscRing<InputCommand, 64>;
+
+// Consumer side, run by the sim right before update for tick. Pushes the
+// commands due by then, oldest first, until the snake accepts one; the
+// snake's own filtering drops reversals and repeats. Later commands stay
+// queued for the following ticks, so quick double turns still land one tick
+// apart.
+template <std::unsigned_integral Coord>
+void apply_inputs(InputQueue &queue, BasicSnake<Coord> &snake, std::uint64_t tick) {
+    while (const InputCommand *command = queue.front()) {
+        if (command->tick > tick) return;
+        const bool accepted = snake.push_direction(command->direction);
+        queue.pop();
+        if (accepted) return;
+    }
+}
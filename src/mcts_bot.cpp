@@ -0,0 +1,196 @@
+#include "mcts_bot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Whether moving the snake in direction survives the next tick.
+bool is_safe(const Snake &snake, const SnakeGrid &grid, Direction direction) {
+    const BodyView body = snake.get_body();
+    const std::optional<Position> next = grid.move_head(body.front(), direction);
+    return next && (!grid.is_snake_body(*next) || *next == body.back());
+}
+
+} // namespace
+
+MctsSettings MctsSettings::for_tick_rate(TickRate rate, double share) {
+    MctsSettings settings;
+    settings.time_budget = rate.seconds_per_tick() * share;
+    return settings;
+}
+
+MctsBot::MctsBot(WorkStealingPool &pool, MctsSettings settings)
+    : pool(&pool), settings(settings), nodes(std::make_unique<Node[]>(std::max<std::size_t>(1, settings.max_nodes))) {}
+
+std::optional<Direction> MctsBot::operator()(const Snake &snake, const SnakeGrid &grid) {
+    if (snake.has_state<DeadSnake>() || snake.has_state<WinnerSnake>()) return std::nullopt;
+
+    if (root) {
+        root->save(grid, snake);
+    } else {
+        root.emplace(grid, snake);
+    }
+    if (workers.empty()) {
+        workers.reserve(pool->get_thread_count());
+        for (std::size_t worker = 0; worker < pool->get_thread_count(); ++worker) {
+            workers.push_back(Worker{grid, snake, Xoshiro256(derive_seed(settings.seed, worker)), {}});
+        }
+    }
+
+    Node &root_node = nodes[0];
+    for (auto &child : root_node.children) child.store(NO_NODE, std::memory_order_relaxed);
+    root_node.visits.store(0, std::memory_order_relaxed);
+    root_node.value.store(0, std::memory_order_relaxed);
+    node_count.store(1, std::memory_order_relaxed);
+    started_rollouts.store(0, std::memory_order_relaxed);
+    finished_rollouts.store(0, std::memory_order_relaxed);
+
+    const auto start = std::chrono::steady_clock::now();
+    deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(settings.time_budget));
+    pool->parallel_for(workers.size(), [this](std::size_t, std::size_t worker) { search(workers[worker]); });
+
+    last_stats.decisions = 1;
+    last_stats.rollouts = finished_rollouts.load(std::memory_order_relaxed);
+    last_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ++total_stats.decisions;
+    total_stats.rollouts += last_stats.rollouts;
+    total_stats.seconds += last_stats.seconds;
+
+    // The most visited turn, but never one that dies at once while another
+    // survives, however the search happened to rank them.
+    const Direction heading = snake.get_next_direction();
+    std::optional<Direction> best;
+    std::uint32_t best_visits = 0;
+    bool best_safe = false;
+    for (std::size_t action = 0; action < root_node.children.size(); ++action) {
+        const auto direction = static_cast<Direction>(action);
+        if (is_opposite(heading, direction)) continue;
+
+        const std::uint32_t child = root_node.children[action].load(std::memory_order_acquire);
+        const std::uint32_t visits = child == NO_NODE ? 0 : nodes[child].visits.load(std::memory_order_relaxed);
+        const bool safe = is_safe(snake, grid, direction);
+        if (child == NO_NODE && !safe) continue;
+
+        if (!best || safe > best_safe || (safe == best_safe && visits > best_visits)) {
+            best = direction;
+            best_visits = visits;
+            best_safe = safe;
+        }
+    }
+    return best;
+}
+
+void MctsBot::search(Worker &worker) {
+    while (true) {
+        if (settings.time_budget > 0) {
+            if (std::chrono::steady_clock::now() >= deadline) return;
+        } else if (started_rollouts.fetch_add(1, std::memory_order_relaxed) >= settings.max_rollouts) {
+            return;
+        }
+
+        root->restore(worker.grid, worker.snake);
+        worker.grid.reseed(worker.rng());
+
+        std::size_t depth = 0;
+        std::uint32_t index = 0;
+        worker.path[0] = 0;
+        nodes[0].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+
+        std::size_t apples = 0;
+        std::size_t moves = 0;
+        std::size_t survived = 0;
+        while (depth < MAX_TREE_DEPTH && !worker.snake.has_state<DeadSnake>() && !worker.snake.has_state<WinnerSnake>()) {
+            Node &node = nodes[index];
+            const std::size_t action = select_action(node, worker.snake.get_next_direction(), worker.rng);
+            std::uint32_t child = node.children[action].load(std::memory_order_acquire);
+            const bool fresh = child == NO_NODE;
+            if (fresh) child = expand(node, action);
+
+            worker.snake.push_direction(static_cast<Direction>(action));
+            apples += worker.snake.update(worker.grid).grew;
+            ++moves;
+            survived += !worker.snake.has_state<DeadSnake>();
+            if (child == NO_NODE) break;
+
+            index = child;
+            worker.path[++depth] = child;
+            nodes[child].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+            if (fresh) break;
+        }
+
+        const double reward = rollout(worker, apples, moves, survived);
+        // Swap each virtual loss for the real result.
+        for (std::size_t i = 0; i <= depth; ++i) {
+            Node &node = nodes[worker.path[i]];
+            node.visits.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+            node.value.fetch_add(reward, std::memory_order_relaxed);
+        }
+        finished_rollouts.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::size_t MctsBot::select_action(const Node &node, Direction heading, Xoshiro256 &rng) const {
+    const double log_visits = std::log(static_cast<double>(std::max<std::uint32_t>(1, node.visits.load(std::memory_order_relaxed))));
+    const std::size_t first = rng() % 4;
+
+    std::size_t best = 0;
+    double best_score = -std::numeric_limits<double>::infinity();
+    for (std::size_t offset = 0; offset < 4; ++offset) {
+        const std::size_t action = (first + offset) % 4;
+        if (is_opposite(heading, static_cast<Direction>(action))) continue;
+
+        const std::uint32_t child = node.children[action].load(std::memory_order_acquire);
+        if (child == NO_NODE) return action;
+
+        const double visits = std::max<std::uint32_t>(1, nodes[child].visits.load(std::memory_order_relaxed));
+        const double score = nodes[child].value.load(std::memory_order_relaxed) / visits +
+                             settings.exploration * std::sqrt(log_visits / visits);
+        if (score > best_score) {
+            best = action;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+std::uint32_t MctsBot::expand(Node &node, std::size_t action) {
+    const std::uint32_t index = node_count.fetch_add(1, std::memory_order_relaxed);
+    if (index >= settings.max_nodes) return NO_NODE;
+
+    Node &child = nodes[index];
+    for (auto &grandchild : child.children) grandchild.store(NO_NODE, std::memory_order_relaxed);
+    child.visits.store(0, std::memory_order_relaxed);
+    child.value.store(0, std::memory_order_relaxed);
+
+    // Another worker may have expanded the same action first; then use its
+    // node and leave this one unused.
+    std::uint32_t expected = NO_NODE;
+    if (node.children[action].compare_exchange_strong(expected, index, std::memory_order_acq_rel)) return index;
+    return expected;
+}
+
+double MctsBot::rollout(Worker &worker, std::size_t apples, std::size_t moves, std::size_t survived) {
+    Snake &snake = worker.snake;
+    SnakeGrid &grid = worker.grid;
+    for (std::size_t step = 0; step < settings.rollout_depth && snake.has_state<AliveSnake>(); ++step) {
+        std::array<Direction, 4> safe;
+        std::size_t safe_count = 0;
+        for (const Direction direction : {Direction::RIGHT, Direction::DOWN, Direction::LEFT, Direction::UP}) {
+            if (is_safe(snake, grid, direction)) safe[safe_count++] = direction;
+        }
+        if (safe_count > 0) snake.push_direction(safe[random_below(worker.rng, safe_count)]);
+        apples += snake.update(grid).grew;
+        survived += !snake.has_state<DeadSnake>();
+    }
+
+    // Survival is worth up to half the reward, by the share of ticks lived
+    // out of the tree moves plus a full rollout, so even late-game rollouts
+    // that all die tell a quick death from a slow one. A win lives them all.
+    // Each apple is worth a quarter, up to two.
+    const std::size_t horizon = moves + settings.rollout_depth;
+    if (snake.has_state<WinnerSnake>()) survived = horizon;
+    return 0.5 * static_cast<double>(survived) / static_cast<double>(horizon) +
+           0.25 * static_cast<double>(std::min<std::size_t>(apples, 2));
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "random.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+struct MctsSettings {
+    // Thinking time per decision in seconds; zero means stop after max_rollouts instead.
+    double time_budget = 0.05;
+    std::size_t max_rollouts = 4096;
+    // Tree size limit; once reached, the search keeps rolling out from the leaves.
+    std::size_t max_nodes = 1 << 16;
+    std::size_t rollout_depth = 64;
+    double exploration = 1.4;
+    std::uint64_t seed = 0;
+
+    // Thinks for share of every tick. Unthrottled games get a fixed number of
+    // rollouts per decision instead.
+    static MctsSettings for_tick_rate(TickRate rate, double share = 0.5);
+};
+
+struct MctsStats {
+    std::size_t decisions = 0;
+    std::size_t rollouts = 0;
+    double seconds = 0;
+
+    double rollouts_per_second() const { return seconds > 0 ? static_cast<double>(rollouts) / seconds : 0; }
+};
+
+// Monte Carlo tree search over the player's turns, run on every worker of a
+// pool at once with a single shared tree (tree parallelism).
+//
+// Each iteration restores a worker-local copy of the game from a Snapshot,
+// reseeds its apples from the worker's own RNG so the search cannot peek at
+// the real apple sequence, walks down the tree by UCT, adds one node, plays
+// a random rollout that avoids immediate deaths, and backs the result up.
+// Workers add a virtual loss to the nodes they pass on the way down, which
+// steers the others onto different branches until the real result arrives.
+//
+// Nodes come from a block allocated once, so the search allocates nothing
+// once the worker copies have grown to the game's size.
+class MctsBot {
+public:
+    // The pool must not be the one running this bot's own game loop.
+    MctsBot(WorkStealingPool &pool, MctsSettings settings);
+
+    // Searches from the current state and returns the most visited turn,
+    // passing over any that dies on the next tick while another survives.
+    std::optional<Direction> operator()(const Snake &snake, const SnakeGrid &grid);
+
+    const MctsStats &get_last_stats() const { return last_stats; }
+    const MctsStats &get_total_stats() const { return total_stats; }
+
+private:
+    static constexpr std::uint32_t NO_NODE = 0;
+    static constexpr std::uint32_t VIRTUAL_LOSS = 1;
+    static constexpr std::size_t MAX_TREE_DEPTH = 64;
+
+    struct Node {
+        std::array<std::atomic<std::uint32_t>, 4> children;
+        std::atomic<std::uint32_t> visits;
+        std::atomic<double> value;
+    };
+
+    struct alignas(64) Worker {
+        SnakeGrid grid;
+        Snake snake;
+        Xoshiro256 rng;
+        std::array<std::uint32_t, MAX_TREE_DEPTH + 1> path;
+    };
+
+    void search(Worker &worker);
+    // The turn to try next from node: an untried one if any, else the best by UCT.
+    std::size_t select_action(const Node &node, Direction heading, Xoshiro256 &rng) const;
+    std::uint32_t expand(Node &node, std::size_t action);
+    // Plays the rest of an iteration at random and scores it; moves, apples
+    // and survived count what the walk down the tree already did.
+    double rollout(Worker &worker, std::size_t apples, std::size_t moves, std::size_t survived);
+
+    WorkStealingPool *pool;
+    MctsSettings settings;
+    std::unique_ptr<Node[]> nodes;
+    std::atomic<std::uint32_t> node_count{0};
+    std::atomic<std::size_t> started_rollouts{0};
+    std::atomic<std::size_t> finished_rollouts{0};
+    std::optional<Snapshot> root;
+    std::vector<Worker> workers;
+    std::chrono::steady_clock::time_point deadline;
+    MctsStats last_stats;
+    MctsStats total_stats;
+};
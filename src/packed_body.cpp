@@ -0,0 +1,86 @@
+#include "packed_body.hpp"
+
+#include <algorithm>
+
+template <std::unsigned_integral Coord>
+BasicPackedBody<Coord>::BasicPackedBody(BasicBodyView<Coord> body) {
+    for (std::size_t i = body.size(); i-- > 0;) push_front(body[i]);
+}
+
+template <std::unsigned_integral Coord>
+void BasicPackedBody<Coord>::push_front(const position_type &position) {
+    if (length == 0) {
+        head = tail = position;
+        length = 1;
+        return;
+    }
+    // length - 1 links are in use.
+    if (length - 1 == capacity()) grow();
+    first = (first - 1) & (capacity() - 1);
+    set_link(first, direction_between(head, position));
+    head = position;
+    ++length;
+}
+
+template <std::unsigned_integral Coord>
+void BasicPackedBody<Coord>::pop_back() {
+    if (--length > 0) tail = step_back(tail, static_cast<Direction>((static_cast<int>(link(length - 1)) + 2) % 4));
+}
+
+template <std::unsigned_integral Coord>
+void BasicPackedBody<Coord>::decode(std::vector<position_type> &positions) const {
+    positions.assign(begin(), end());
+}
+
+template <std::unsigned_integral Coord>
+bool BasicPackedBody<Coord>::operator==(const BasicPackedBody &other) const {
+    if (length != other.length || head != other.head) return false;
+    for (std::size_t i = 0; i + 1 < length; ++i) {
+        if (link(i) != other.link(i)) return false;
+    }
+    return true;
+}
+
+template <std::unsigned_integral Coord>
+typename BasicPackedBody<Coord>::position_type BasicPackedBody<Coord>::step_back(position_type position, Direction direction) {
+    // Undoes a move in direction; segments are always on the board, so no bounds checks.
+    switch (direction) {
+    case Direction::RIGHT: --position.col; break;
+    case Direction::DOWN: --position.row; break;
+    case Direction::LEFT: ++position.col; break;
+    case Direction::UP: ++position.row; break;
+    }
+    return position;
+}
+
+template <std::unsigned_integral Coord>
+Direction BasicPackedBody<Coord>::direction_between(position_type from, position_type to) {
+    if (to.row == from.row) return to.col > from.col ? Direction::RIGHT : Direction::LEFT;
+    return to.row > from.row ? Direction::DOWN : Direction::UP;
+}
+
+template <std::unsigned_integral Coord>
+void BasicPackedBody<Coord>::set_link(std::size_t slot, Direction direction) {
+    std::uint64_t &word = links[slot / LINKS_PER_WORD];
+    const std::size_t shift = slot % LINKS_PER_WORD * 2;
+    word = (word & ~(std::uint64_t{3} << shift)) | (static_cast<std::uint64_t>(direction) << shift);
+}
+
+template <std::unsigned_integral Coord>
+void BasicPackedBody<Coord>::grow() {
+    // Re-lay the links from slot 0 into a buffer twice the size, which stays a
+    // power of two so slots wrap with a mask.
+    const std::size_t used = length - 1;
+    std::vector<std::uint64_t> old_links = std::move(links);
+    const std::size_t old_capacity = old_links.size() * LINKS_PER_WORD;
+    links.assign(std::max<std::size_t>(1, old_links.size() * 2), 0);
+    for (std::size_t i = 0; i < used; ++i) {
+        const std::size_t slot = (first + i) & (old_capacity - 1);
+        set_link(i, static_cast<Direction>((old_links[slot / LINKS_PER_WORD] >> (slot % LINKS_PER_WORD * 2)) & 3));
+    }
+    first = 0;
+}
+
+template class BasicPackedBody<std::uint8_t>;
+template class BasicPackedBody<std::uint16_t>;
+template class BasicPackedBody<std::uint32_t>;
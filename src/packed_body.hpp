@@ -0,0 +1,105 @@
+#pragma once
+
+#include "snake.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// Snake body stored as its head and tail positions plus 2 bits per link
+// between neighbouring segments, about 16x smaller than a position per
+// segment. Like BasicRingBody it is a circular buffer, so push_front and
+// pop_back are O(1); positions are decoded on the fly by the iterator.
+//
+// Each link holds the direction of travel from the later segment to the
+// earlier one, i.e. the direction the head moved when it was pushed.
+template <std::unsigned_integral Coord>
+class BasicPackedBody {
+public:
+    using position_type = BasicPosition<Coord>;
+
+    // Walks the body head first, one step per link. Positions are decoded
+    // into the iterator, so it yields them by value and is an input iterator.
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = position_type;
+        using reference = position_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        position_type operator*() const { return position; }
+
+        iterator &operator++() {
+            if (++index < body->length) position = step_back(position, body->link(index - 1));
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator &other) const { return index == other.index; }
+
+    private:
+        friend class BasicPackedBody;
+
+        iterator(const BasicPackedBody *body, std::size_t index, position_type position)
+            : body(body), index(index), position(position) {}
+
+        const BasicPackedBody *body = nullptr;
+        std::size_t index = 0;
+        position_type position{};
+    };
+
+    BasicPackedBody() = default;
+    explicit BasicPackedBody(BasicBodyView<Coord> body);
+
+    // position must be a neighbour of the current head (or the body empty).
+    void push_front(const position_type &position);
+    void pop_back();
+
+    std::size_t size() const { return length; }
+
+    const position_type &front() const { return head; }
+    const position_type &back() const { return tail; }
+
+    iterator begin() const { return {this, 0, head}; }
+    iterator end() const { return {this, length, {}}; }
+
+    // Link i joins segment i + 1 to segment i.
+    Direction link(std::size_t i) const {
+        const std::size_t slot = (first + i) & (capacity() - 1);
+        return static_cast<Direction>((links[slot / LINKS_PER_WORD] >> (slot % LINKS_PER_WORD * 2)) & 3);
+    }
+
+    // Copies the body out into positions, head first; the vector is reused.
+    void decode(std::vector<position_type> &positions) const;
+
+    bool operator==(const BasicPackedBody &other) const;
+
+private:
+    static constexpr std::size_t LINKS_PER_WORD = 32;
+
+    static position_type step_back(position_type position, Direction direction);
+    static Direction direction_between(position_type from, position_type to);
+
+    std::size_t capacity() const { return links.size() * LINKS_PER_WORD; }
+    void set_link(std::size_t slot, Direction direction);
+    void grow();
+
+    std::vector<std::uint64_t> links;
+    std::size_t first = 0;
+    std::size_t length = 0;
+    position_type head{};
+    position_type tail{};
+};
+
+using PackedBody = BasicPackedBody<std::uint16_t>;
+
+extern template class BasicPackedBody<std::uint8_t>;
+extern template class BasicPackedBody<std::uint16_t>;
+extern template class BasicPackedBody<std::uint32_t>;
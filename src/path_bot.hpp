@@ -0,0 +1,98 @@
+#pragma once
+
+#include "snake.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Bot that takes a shortest path to the apple, found by breadth-first search
+// around the body. If the apple cannot be reached it heads for the neighbour
+// with the most room behind it, to stall until a path opens up.
+//
+// The frontier and the per-cell buffers are sized once per board, and cells
+// are marked visited with a stamp that changes every search instead of
+// clearing, so once warmed up a decision does no heap allocation. One bot per
+// thread; it can be used as the input source of BasicSnake::advance and with
+// run_games.
+class PathBot {
+public:
+    template <GridLike Grid>
+    void start_game(const Grid &grid, std::uint64_t) {
+        reserve(grid.get_width() * grid.get_height());
+    }
+
+    template <GridLike Grid>
+    std::optional<Direction> operator()(const BasicSnake<typename Grid::coord_type> &snake, const Grid &grid);
+
+private:
+    void reserve(std::size_t cells) {
+        if (visited.size() >= cells) return;
+        visited.assign(cells, 0);
+        first_moves.resize(cells);
+        frontier_cells.resize(cells);
+        stamp = 0;
+    }
+
+    std::vector<std::uint32_t> visited;
+    std::vector<Direction> first_moves;
+    // Queue of cells to expand, as row * width + col.
+    std::vector<std::uint32_t> frontier_cells;
+    std::uint32_t stamp = 0;
+};
+
+template <GridLike Grid>
+std::optional<Direction> PathBot::operator()(const BasicSnake<typename Grid::coord_type> &snake, const Grid &grid) {
+    using position_type = typename Grid::position_type;
+    using coord_type = typename Grid::coord_type;
+
+    const std::size_t width = grid.get_width();
+    reserve(width * grid.get_height());
+    if (++stamp == 0) {
+        std::ranges::fill(visited, 0);
+        stamp = 1;
+    }
+
+    const auto body = snake.get_body();
+    const position_type head = body.front();
+    // The tail moves away this tick, unless the snake is eating.
+    const position_type tail = body.back();
+    const position_type apple = grid.get_apple_position();
+    const auto to_index = [width](position_type position) {
+        return static_cast<std::uint32_t>(position.row * width + position.col);
+    };
+
+    std::array<std::size_t, 4> room{};
+    std::size_t read = 0;
+    std::size_t write = 0;
+    frontier_cells[write++] = to_index(head);
+    visited[to_index(head)] = stamp;
+
+    while (read < write) {
+        const std::uint32_t cell = frontier_cells[read++];
+        const position_type position{static_cast<coord_type>(cell / width), static_cast<coord_type>(cell % width)};
+
+        for (const Direction direction : {Direction::RIGHT, Direction::DOWN, Direction::LEFT, Direction::UP}) {
+            const std::optional<position_type> next = grid.move_head(position, direction);
+            if (!next) continue;
+
+            const std::uint32_t next_cell = to_index(*next);
+            if (visited[next_cell] == stamp) continue;
+            if (grid.is_snake_body(*next) && *next != tail) continue;
+
+            visited[next_cell] = stamp;
+            const Direction first_move = position == head ? direction : first_moves[cell];
+            first_moves[next_cell] = first_move;
+            if (*next == apple) return first_move;
+
+            ++room[static_cast<std::size_t>(first_move)];
+            frontier_cells[write++] = next_cell;
+        }
+    }
+
+    const auto roomiest = std::ranges::max_element(room);
+    if (*roomiest == 0) return std::nullopt;
+    return static_cast<Direction>(roomiest - room.begin());
+}
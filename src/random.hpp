@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+constexpr std::uint64_t splitmix64(std::uint64_t &state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+// Independent seed for the index-th item of a seeded workload.
+constexpr std::uint64_t derive_seed(std::uint64_t seed, std::uint64_t index) {
+    std::uint64_t state = seed ^ (index * 0xd1342543de82ef95);
+    return splitmix64(state);
+}
+
+// xoshiro256** (Blackman & Vigna). 32 bytes of state, cheap to copy and
+// seed, so every grid can own one.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit constexpr Xoshiro256(std::uint64_t seed) {
+        for (auto &word : state) word = splitmix64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    constexpr result_type operator()() {
+        const std::uint64_t result = std::rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = std::rotl(state[3], 45);
+
+        return result;
+    }
+
+    bool operator==(const Xoshiro256 &other) const = default;
+
+private:
+    std::array<std::uint64_t, 4> state{};
+};
+
+// High 64 bits of a * b.
+constexpr std::uint64_t multiply_high(std::uint64_t a, std::uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    const std::uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32;
+    const std::uint64_t b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low;
+    const std::uint64_t high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high;
+    const std::uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    return a_high * b_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+// Uniform integer in [0, bound), bound > 0, by Lemire's multiply-shift with
+// rejection. Unlike std::uniform_int_distribution, whose algorithm is up to
+// the standard library, it maps a seed to the same values everywhere, so
+// seeded games replay identically across compilers.
+template <typename Rng>
+constexpr std::uint64_t random_below(Rng &rng, std::uint64_t bound) {
+    std::uint64_t value = rng();
+    std::uint64_t low = value * bound;
+    if (low < bound) {
+        const std::uint64_t threshold = -bound % bound;
+        while (low < threshold) {
+            value = rng();
+            low = value * bound;
+        }
+    }
+    return multiply_high(value, bound);
+}
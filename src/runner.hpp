@@ -0,0 +1,135 @@
+#pragma once
+
+#include "snake.hpp"
+#include "thread_pool.hpp"
+#include "timer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// "Run games games on width x height boards with seed seed." Game i is seeded
+// with derive_seed(seed, i), so results do not depend on scheduling.
+struct Workload {
+    std::size_t games = 1;
+    std::size_t width = 10;
+    std::size_t height = 9;
+    std::uint64_t seed = 0;
+    // Games still running after this many ticks are stopped and counted as timeouts.
+    std::size_t max_ticks = 1'000'000;
+};
+
+struct GameStats {
+    std::size_t games = 0;
+    std::size_t ticks = 0;
+    std::size_t apples = 0;
+    std::size_t wins = 0;
+    std::size_t wall_deaths = 0;
+    std::size_t self_deaths = 0;
+    std::size_t timeouts = 0;
+    std::size_t final_length_sum = 0;
+    // Final lengths of the games that ended in a death.
+    std::size_t death_length_sum = 0;
+    // Number of games by apples eaten.
+    std::vector<std::size_t> apple_histogram;
+    double seconds = 0;
+
+    void merge(const GameStats &other) {
+        games += other.games;
+        ticks += other.ticks;
+        apples += other.apples;
+        wins += other.wins;
+        wall_deaths += other.wall_deaths;
+        self_deaths += other.self_deaths;
+        timeouts += other.timeouts;
+        final_length_sum += other.final_length_sum;
+        death_length_sum += other.death_length_sum;
+        if (apple_histogram.size() < other.apple_histogram.size()) apple_histogram.resize(other.apple_histogram.size());
+        for (std::size_t apples = 0; apples < other.apple_histogram.size(); ++apples) {
+            apple_histogram[apples] += other.apple_histogram[apples];
+        }
+    }
+
+    // Apples eaten in the game at quantile q (0 to 1) of the score distribution.
+    std::size_t apple_quantile(double q) const {
+        const auto rank = static_cast<std::size_t>(q * static_cast<double>(games > 0 ? games - 1 : 0));
+        std::size_t seen = 0;
+        for (std::size_t apples = 0; apples < apple_histogram.size(); ++apples) {
+            seen += apple_histogram[apples];
+            if (seen > rank) return apples;
+        }
+        return 0;
+    }
+
+    double ticks_per_second() const { return seconds > 0 ? static_cast<double>(ticks) / seconds : 0; }
+    double games_per_second() const { return seconds > 0 ? static_cast<double>(games) / seconds : 0; }
+};
+
+// Policies that keep per-game state can opt in to being told about new games.
+template <typename Policy>
+concept GameAwarePolicy = requires(Policy &policy, const SnakeGrid &grid, std::uint64_t seed) {
+    policy.start_game(grid, seed);
+};
+
+// Plays game number game of a workload with policy and records it in stats.
+// Returns the apples eaten, e.g. to compare policies on the same seed.
+template <typename Policy>
+std::size_t play_game(const Workload &workload, std::size_t game, Policy &policy, GameStats &stats) {
+    const std::uint64_t seed = derive_seed(workload.seed, game);
+
+    SnakeGrid grid(workload.width, workload.height, seed);
+    Snake snake(grid, Position{static_cast<std::uint16_t>(workload.height / 2), 4});
+    if constexpr (GameAwarePolicy<Policy>) policy.start_game(grid, seed);
+
+    const AdvanceSummary summary = snake.advance(grid, workload.max_ticks, policy);
+
+    ++stats.games;
+    stats.ticks += summary.ticks;
+    stats.apples += summary.apples;
+    stats.final_length_sum += snake.get_body().size();
+    if (stats.apple_histogram.size() <= summary.apples) stats.apple_histogram.resize(summary.apples + 1);
+    ++stats.apple_histogram[summary.apples];
+    if (snake.has_state<WinnerSnake>()) {
+        ++stats.wins;
+    } else if (summary.death == DeathCause::WALL) {
+        ++stats.wall_deaths;
+    } else if (summary.death == DeathCause::SELF) {
+        ++stats.self_deaths;
+    } else {
+        ++stats.timeouts;
+    }
+    if (snake.has_state<DeadSnake>()) stats.death_length_sum += snake.get_body().size();
+    return summary.apples;
+}
+
+// Plays a workload on every core of the pool. make_policy(worker) is called
+// once per worker and its result is used as the input source of
+// BasicSnake::advance for every game that worker plays; per-worker stats are
+// merged at the end.
+template <typename PolicyFactory>
+GameStats run_games(WorkStealingPool &pool, const Workload &workload, PolicyFactory &&make_policy) {
+    using Policy = decltype(make_policy(std::size_t{}));
+
+    struct alignas(64) WorkerState {
+        std::unique_ptr<Policy> policy;
+        GameStats stats;
+    };
+
+    std::vector<WorkerState> workers(pool.get_thread_count());
+    for (std::size_t worker = 0; worker < workers.size(); ++worker) {
+        workers[worker].policy = std::make_unique<Policy>(make_policy(worker));
+    }
+
+    Timer timer;
+    timer.start();
+
+    pool.parallel_for(workload.games, [&](std::size_t game, std::size_t worker) {
+        WorkerState &state = workers[worker];
+        play_game(workload, game, *state.policy, state.stats);
+    });
+
+    GameStats total;
+    for (const WorkerState &worker : workers) total.merge(worker.stats);
+    total.seconds = timer.elapsed<std::chrono::duration<double>>().count();
+    return total;
+}
@@ -1,73 +1,179 @@
 #pragma once
 
+#include "grid.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <variant>
 
-constexpr inline double TPS = 8;
-constexpr inline double SPT = 1.0 / TPS;
+// How fast one game runs. Every game carries its own rate, so rooms with
+// different speeds can share a process. Zero ticks per second is unthrottled:
+// one tick each time the game is stepped, for headless fast-forward.
+struct TickRate {
+    double ticks_per_second = 8;
 
-struct Position {
-    std::size_t row;
-    std::size_t col;
+    constexpr bool is_unthrottled() const { return ticks_per_second <= 0; }
+    constexpr double seconds_per_tick() const { return is_unthrottled() ? 0 : 1 / ticks_per_second; }
 
-    bool operator==(const Position &other) const {
-        return row == other.row && col == other.col;
-    }
+    static constexpr TickRate unthrottled() { return TickRate{0}; }
+
+    bool operator==(const TickRate &) const = default;
 };
 
-enum class Direction {
-    RIGHT,
-    DOWN,
-    LEFT,
-    UP,
+// The snake body as seen from outside, head first. The ring buffer wraps at
+// most once, so the body is always two contiguous pieces.
+template <std::unsigned_integral Coord>
+struct BasicBodyView {
+    using position_type = BasicPosition<Coord>;
+
+    BasicBodyView(std::span<const position_type> first, std::span<const position_type> second = {})
+        : first(first), second(second) {}
+
+    std::size_t size() const { return first.size() + second.size(); }
+
+    const position_type &operator[](std::size_t i) const {
+        return i < first.size() ? first[i] : second[i - first.size()];
+    }
+
+    const position_type &front() const { return (*this)[0]; }
+    const position_type &back() const { return (*this)[size() - 1]; }
+
+    std::span<const position_type> first;
+    std::span<const position_type> second;
 };
 
-class SnakeGrid {
+using BodyView = BasicBodyView<std::uint16_t>;
+
+// Circular buffer of body positions, head first. Moving the snake is a
+// push_front plus a pop_back, so a tick costs O(1) regardless of length.
+template <std::unsigned_integral Coord>
+class BasicRingBody {
 public:
-    SnakeGrid(std::size_t width, std::size_t height);
+    using position_type = BasicPosition<Coord>;
+
+    void push_front(const position_type &position) {
+        if (length == buffer.size()) grow();
+        head = (head - 1) & (buffer.size() - 1);
+        buffer[head] = position;
+        ++length;
+    }
 
-    void set_snake_body(Position position, bool value);
+    void pop_back() { --length; }
 
-    bool is_snake_body(Position position) const;
+    std::size_t size() const { return length; }
 
-    std::optional<Position> move_head(Position head, Direction direction) const;
+    const position_type &operator[](std::size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
 
-    std::size_t get_width() const { return width; }
-    std::size_t get_height() const { return height; }
+    const position_type &front() const { return buffer[head]; }
+    const position_type &back() const { return (*this)[length - 1]; }
 
-    void shuffle_apple();
+    BasicBodyView<Coord> view() const {
+        const std::size_t first_size = std::min(length, buffer.size() - head);
+        return {std::span{buffer}.subspan(head, first_size), std::span{buffer}.first(length - first_size)};
+    }
 
-    const Position &get_apple_position() const { return apple; }
+    // Compares the body, not how it happens to sit in the buffer.
+    bool operator==(const BasicRingBody &other) const;
 
 private:
-    std::vector<bool> flat_grid;
-    Position apple;
-    std::size_t width;
-    std::size_t height;
-    std::size_t empty_cells;
+    void grow();
+
+    std::vector<position_type> buffer;
+    std::size_t head = 0;
+    std::size_t length = 0;
+};
+
+using RingBody = BasicRingBody<std::uint16_t>;
+
+enum class DeathCause : std::uint8_t {
+    NONE,
+    WALL,
+    SELF,
+    // Arena only: ran into another snake, or into the same cell as another head.
+    OTHER,
+    HEAD_ON,
+};
+
+bool is_opposite(Direction a, Direction b);
+
+// Everything a single update changed, so renderers, encoders and counters can
+// react in O(1) instead of diffing the body or the grid.
+template <std::unsigned_integral Coord>
+struct BasicTickEvents {
+    BasicPosition<Coord> head{};       // New head cell, valid if moved.
+    BasicPosition<Coord> freed_tail{}; // Vacated cell, valid if tail_freed().
+    BasicPosition<Coord> apple{};      // Respawned apple cell, valid if grew (unless that won).
+    bool moved = false;
+    bool grew = false;
+    DeathCause death = DeathCause::NONE;
+
+    bool tail_freed() const { return moved && !grew; }
 };
 
+using TickEvents = BasicTickEvents<std::uint16_t>;
 
-struct PreStartSnake {};
+// Totals over the ticks run by BasicSnake::advance.
+struct AdvanceSummary {
+    std::size_t ticks = 0;
+    std::size_t apples = 0;
+    DeathCause death = DeathCause::NONE;
+};
+
+struct PreStartSnake {
+    bool operator==(const PreStartSnake &) const = default;
+};
 
 struct AliveSnake {
-    std::optional<std::pair<Direction, std::optional<Direction>>> next_direction;
+    // The turn for the coming tick. Turns for later ticks wait in an InputQueue.
+    std::optional<Direction> next_direction;
 
     Direction get_next_direction(Direction last_direction) const;
+
+    bool operator==(const AliveSnake &) const = default;
+};
+struct DeadSnake {
+    DeathCause cause;
+
+    bool operator==(const DeadSnake &) const = default;
 };
-struct DeadSnake {};
-struct WinnerSnake {};
+struct WinnerSnake {
+    bool operator==(const WinnerSnake &) const = default;
+};
+
+// What a BasicSnake<Coord> can run on: any grid with matching coordinates.
+template <typename T, typename Coord>
+concept GridFor = GridLike<T> && std::same_as<typename T::coord_type, Coord>;
 
-class Snake {
+template <std::unsigned_integral Coord>
+class BasicSnake {
 public:
-    Snake(SnakeGrid &grid, const Position &position);
+    using position_type = BasicPosition<Coord>;
+
+    template <GridFor<Coord> Grid>
+    BasicSnake(Grid &grid, const position_type &position);
 
-    bool update(SnakeGrid &grid);
+    template <GridFor<Coord> Grid>
+    BasicTickEvents<Coord> update(Grid &grid);
 
-    std::span<const Position> get_body() const { return body; }
-    void push_direction(Direction visited_state);
+    // Runs up to ticks updates back to back, with no timing, stopping early once
+    // the snake has died or won. Before each tick input_source(snake, grid) may
+    // return a Direction (or an optional one) to push; ticks before the first
+    // accepted direction pass with the snake waiting, as in a live game.
+    template <GridFor<Coord> Grid, typename InputSource>
+        requires std::invocable<InputSource &, const BasicSnake &, const Grid &>
+    AdvanceSummary advance(Grid &grid, std::size_t ticks, InputSource &&input_source);
+
+    BasicBodyView<Coord> get_body() const { return body.view(); }
+    // Sets the turn for the next tick. Returns false if it was dropped: a
+    // reversal, no change of direction, or a turn already set for this tick.
+    bool push_direction(Direction direction);
 
     decltype(auto) visit_state(auto &&visitor) {
         return std::visit(std::forward<decltype(visitor)>(visitor), state);
@@ -76,13 +182,111 @@ public:
     template <typename T>
     bool has_state() const { return std::holds_alternative<T>(state); }
 
-    const Position &get_previous_tail_position() const { return previous_tail_position; }
+    const position_type &get_previous_tail_position() const { return previous_tail_position; }
 
     Direction get_next_direction() const;
 
+    // The grid's Zobrist hash with this snake's head cell and heading folded in.
+    template <GridFor<Coord> Grid>
+    std::uint64_t get_hash(const Grid &grid) const {
+        return grid.get_hash() ^ zobrist_key(ZobristFeature::HEAD, grid.to_cell(body.front())) ^
+               zobrist_key(ZobristFeature::HEADING, static_cast<std::uint64_t>(last_direction));
+    }
+
+    bool operator==(const BasicSnake &) const = default;
+
 private:
-    std::vector<Position> body{};
+    BasicRingBody<Coord> body{};
     Direction last_direction;
-    Position previous_tail_position;
+    position_type previous_tail_position;
     std::variant<PreStartSnake, AliveSnake, DeadSnake, WinnerSnake> state {PreStartSnake{}};
 };
+
+using Snake = BasicSnake<std::uint16_t>;
+
+extern template class BasicRingBody<std::uint8_t>;
+extern template class BasicRingBody<std::uint16_t>;
+extern template class BasicRingBody<std::uint32_t>;
+extern template class BasicSnake<std::uint8_t>;
+extern template class BasicSnake<std::uint16_t>;
+extern template class BasicSnake<std::uint32_t>;
+
+template <std::unsigned_integral Coord>
+template <GridFor<Coord> Grid>
+BasicSnake<Coord>::BasicSnake(Grid &grid, const position_type &position) : last_direction(Direction::RIGHT) {
+    const Coord row = position.row;
+    const Coord col = position.col;
+    for (Coord i = 4; i-- > 0;) {
+        body.push_front(position_type{row, static_cast<Coord>(col - i)});
+        grid.set_snake_body(body.front(), true);
+    }
+    previous_tail_position = body.back();
+}
+
+template <std::unsigned_integral Coord>
+template <GridFor<Coord> Grid>
+BasicTickEvents<Coord> BasicSnake<Coord>::update(Grid &grid) {
+    BasicTickEvents<Coord> events;
+    if (!has_state<AliveSnake>())
+        return events;
+
+    AliveSnake &alive_state = std::get<AliveSnake>(state);
+
+    const Direction direction = get_next_direction();
+    alive_state.next_direction.reset();
+
+    if (auto new_position = grid.move_head(body.front(), direction)) {
+        if (grid.is_snake_body(*new_position) && *new_position != body.back()) {
+            state = DeadSnake{DeathCause::SELF};
+            events.death = DeathCause::SELF;
+            return events;
+        }
+        const bool eaten_apple = *new_position == grid.get_apple_position();
+        last_direction = direction;
+
+        previous_tail_position = body.back();
+        if (!eaten_apple) {
+            grid.set_snake_body(body.back(), false);
+            body.pop_back();
+        }
+        body.push_front(*new_position);
+        grid.set_snake_body(body.front(), true);
+
+        events.moved = true;
+        events.head = *new_position;
+        events.freed_tail = previous_tail_position;
+        if (eaten_apple) {
+            events.grew = true;
+            // The body fills the board: nowhere left for an apple.
+            if (grid.get_free_cell_count() == 0) {
+                state = WinnerSnake{};
+                return events;
+            }
+            grid.shuffle_apple();
+            events.apple = grid.get_apple_position();
+        }
+    } else {
+        state = DeadSnake{DeathCause::WALL};
+        events.death = DeathCause::WALL;
+    }
+    return events;
+}
+
+template <std::unsigned_integral Coord>
+template <GridFor<Coord> Grid, typename InputSource>
+    requires std::invocable<InputSource &, const BasicSnake<Coord> &, const Grid &>
+AdvanceSummary BasicSnake<Coord>::advance(Grid &grid, std::size_t ticks, InputSource &&input_source) {
+    AdvanceSummary summary;
+    for (; summary.ticks < ticks && !has_state<DeadSnake>() && !has_state<WinnerSnake>(); ++summary.ticks) {
+        if constexpr (std::same_as<std::invoke_result_t<InputSource &, const BasicSnake &, const Grid &>, Direction>) {
+            push_direction(input_source(std::as_const(*this), std::as_const(grid)));
+        } else if (const std::optional<Direction> direction = input_source(std::as_const(*this), std::as_const(grid))) {
+            push_direction(*direction);
+        }
+
+        const BasicTickEvents<Coord> events = update(grid);
+        summary.apples += events.grew;
+        summary.death = events.death;
+    }
+    return summary;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "snake.hpp"
+
+// Complete single-player game state: the grid (occupancy, free-cell index,
+// apple, RNG) and the snake (body, direction, previous tail, state).
+//
+// Saving and restoring copy-assign into storage that already exists, so once
+// the buffers have reached the game's size a rollout loop never allocates.
+// For a FixedSnakeGrid everything but the snake body is inline.
+template <typename Grid>
+class BasicSnapshot {
+public:
+    using snake_type = BasicSnake<typename Grid::coord_type>;
+
+    BasicSnapshot(const Grid &grid, const snake_type &snake) : grid(grid), snake(snake) {}
+
+    void save(const Grid &from_grid, const snake_type &from_snake) {
+        grid = from_grid;
+        snake = from_snake;
+    }
+
+    void restore(Grid &to_grid, snake_type &to_snake) const {
+        to_grid = grid;
+        to_snake = snake;
+    }
+
+    // Compares game state only; see BasicSnakeGrid::operator==. A restore
+    // also copies the free-cell order, so it replays the saved game exactly.
+    bool matches(const Grid &other_grid, const snake_type &other_snake) const {
+        return grid == other_grid && snake == other_snake;
+    }
+
+    const Grid &get_grid() const { return grid; }
+    const snake_type &get_snake() const { return snake; }
+
+    bool operator==(const BasicSnapshot &) const = default;
+
+private:
+    Grid grid;
+    snake_type snake;
+};
+
+using Snapshot = BasicSnapshot<SnakeGrid>;
@@ -0,0 +1,101 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count)
+    : worker_count(std::max<std::size_t>(1, thread_count)), ranges(std::make_unique<WorkRange[]>(worker_count)) {
+    threads.reserve(worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; ++worker) {
+        threads.emplace_back([this, worker] { worker_loop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    start_condition.notify_all();
+    // Join before the mutex and condition variables go away.
+    threads.clear();
+}
+
+void WorkStealingPool::parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)> &body) {
+    for (std::size_t worker = 0; worker < worker_count; ++worker) {
+        std::lock_guard lock(ranges[worker].mutex);
+        ranges[worker].begin = count * worker / worker_count;
+        ranges[worker].end = count * (worker + 1) / worker_count;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        job = &body;
+        running = worker_count - 1;
+        ++generation;
+    }
+    start_condition.notify_all();
+
+    drain(0);
+
+    std::unique_lock lock(mutex);
+    done_condition.wait(lock, [this] { return running == 0; });
+    job = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t worker) {
+    std::size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            start_condition.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) return;
+            seen_generation = generation;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard lock(mutex);
+            --running;
+        }
+        done_condition.notify_one();
+    }
+}
+
+void WorkStealingPool::drain(std::size_t worker) {
+    std::size_t index;
+    do {
+        while (pop(worker, index)) (*job)(index, worker);
+    } while (steal(worker));
+}
+
+bool WorkStealingPool::pop(std::size_t worker, std::size_t &index) {
+    WorkRange &range = ranges[worker];
+    std::lock_guard lock(range.mutex);
+    if (range.begin == range.end) return false;
+    index = range.begin++;
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t thief) {
+    for (std::size_t offset = 1; offset < worker_count; ++offset) {
+        WorkRange &victim = ranges[(thief + offset) % worker_count];
+        std::size_t begin, end;
+        {
+            std::lock_guard lock(victim.mutex);
+            const std::size_t remaining = victim.end - victim.begin;
+            if (remaining == 0) continue;
+            // Leave the victim the front half it is about to work on.
+            begin = victim.end - (remaining + 1) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        WorkRange &own = ranges[thief];
+        std::lock_guard lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running parallel loops with work stealing.
+// Each worker starts on its own contiguous slice of the index range and, once
+// that runs dry, steals the back half of another worker's remaining slice, so
+// wildly uneven items (a game dying at tick 5 next to one filling the board)
+// still keep every core busy.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t thread_count = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Number of workers, counting the thread that calls parallel_for.
+    std::size_t get_thread_count() const { return worker_count; }
+
+    // Calls body(index, worker) once for every index below count and returns
+    // when all calls are done. The calling thread takes part as worker 0.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)> &body);
+
+private:
+    struct alignas(64) WorkRange {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    void worker_loop(std::size_t worker);
+    void drain(std::size_t worker);
+    bool pop(std::size_t worker, std::size_t &index);
+    bool steal(std::size_t thief);
+
+    std::size_t worker_count;
+    std::unique_ptr<WorkRange[]> ranges;
+    std::vector<std::jthread> threads;
+
+    std::mutex mutex;
+    std::condition_variable start_condition;
+    std::condition_variable done_condition;
+    const std::function<void(std::size_t, std::size_t)> *job = nullptr;
+    std::size_t generation = 0;
+    std::size_t running = 0;
+    bool stopping = false;
+};
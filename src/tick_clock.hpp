@@ -0,0 +1,95 @@
+#pragma once
+
+#include "snake.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Fixed-timestep scheduler for a game loop. Each frame the caller passes the
+// current game time; the clock banks it and runs every whole tick that has
+// come due, so slow frames catch up with several ticks instead of losing them.
+// Catching up is capped per call, and time beyond the cap is dropped, so a
+// machine that cannot keep up slows the game down rather than spiralling.
+//
+// What is left in the bank afterwards, as a fraction of a tick, is the
+// interpolation alpha for rendering between the last tick and the next.
+class TickClock {
+public:
+    // Called once per tick with the number of the tick, starting at 0.
+    using Hook = std::function<void(std::uint64_t)>;
+
+    static constexpr std::size_t DEFAULT_MAX_CATCH_UP = 5;
+
+    explicit TickClock(TickRate rate, std::size_t max_catch_up = DEFAULT_MAX_CATCH_UP)
+        : rate(rate), max_catch_up(max_catch_up) {}
+
+    // Subsystems that run on the game's ticks (bots, networking) register
+    // here. Hooks run after the caller's own tick, in the order they were added.
+    void add_hook(Hook hook) { hooks.push_back(std::move(hook)); }
+
+    // Runs the ticks due by time (seconds, never decreasing), calling
+    // on_tick(tick) and then the hooks for each; returns how many ran. An
+    // unthrottled clock runs exactly one tick per call.
+    template <std::invocable<std::uint64_t> OnTick>
+    std::size_t advance_to(double time, OnTick &&on_tick) {
+        const double elapsed = time - last_time;
+        last_time = time;
+
+        if (rate.is_unthrottled()) {
+            run_tick(on_tick);
+            return 1;
+        }
+
+        const double seconds_per_tick = rate.seconds_per_tick();
+        accumulator += elapsed;
+        std::size_t ran = 0;
+        for (; accumulator >= seconds_per_tick && ran < max_catch_up; ++ran) {
+            accumulator -= seconds_per_tick;
+            run_tick(on_tick);
+        }
+        if (accumulator >= seconds_per_tick) {
+            const double behind = std::floor(accumulator / seconds_per_tick);
+            dropped_ticks += static_cast<std::uint64_t>(behind);
+            accumulator = std::max(0.0, accumulator - behind * seconds_per_tick);
+        }
+        return ran;
+    }
+
+    std::size_t advance_to(double time) {
+        return advance_to(time, [](std::uint64_t) {});
+    }
+
+    // How far the game is between the last tick and the next, in [0, 1).
+    double get_alpha() const {
+        return rate.is_unthrottled() ? 0 : std::min(accumulator / rate.seconds_per_tick(), 1.0);
+    }
+
+    // Takes effect from the next advance_to; banked time carries over.
+    void set_rate(TickRate new_rate) { rate = new_rate; }
+    TickRate get_rate() const { return rate; }
+
+    std::uint64_t get_tick() const { return tick; }
+    // Ticks given up to the catch-up cap since the clock started.
+    std::uint64_t get_dropped_ticks() const { return dropped_ticks; }
+
+private:
+    template <typename OnTick>
+    void run_tick(OnTick &on_tick) {
+        on_tick(tick);
+        for (const Hook &hook : hooks) hook(tick);
+        ++tick;
+    }
+
+    TickRate rate;
+    std::size_t max_catch_up;
+    std::vector<Hook> hooks;
+    double last_time = 0;
+    double accumulator = 0;
+    std::uint64_t tick = 0;
+    std::uint64_t dropped_ticks = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 
 class Timer {
     using clock = std::chrono::high_resolution_clock;
@@ -0,0 +1,243 @@
+// Headless bot tournament: plays seeded games with the engine's own Snake
+// rules on every core and prints score distributions, win rates and
+// throughput. No raylib involved.
+//
+//   SnakeTournament [options] bot...
+//
+// Bots: random, path, hamilton, mcts. Each bot is scored solo on the same
+// seeds; with --versus every game is also played by every bot and they are
+// ranked pairwise by apples eaten on that seed.
+
+#include "../hamilton_bot.hpp"
+#include "../mcts_bot.hpp"
+#include "../path_bot.hpp"
+#include "../runner.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TournamentSettings {
+    Workload workload{.games = 10'000, .width = 10, .height = 9, .seed = 1, .max_ticks = 100'000};
+    std::size_t threads = std::thread::hardware_concurrency();
+    std::size_t mcts_rollouts = 200;
+    bool versus = false;
+    std::vector<std::string_view> bots;
+};
+
+class RandomBot {
+public:
+    void start_game(const SnakeGrid &, std::uint64_t seed) { rng = Xoshiro256(seed); }
+
+    Direction operator()(const Snake &, const SnakeGrid &) { return static_cast<Direction>(rng() % 4); }
+
+private:
+    Xoshiro256 rng{0};
+};
+
+// Any bot behind one type, so bots can be picked by name at runtime.
+class AnyBot {
+public:
+    template <typename Bot>
+    explicit AnyBot(std::shared_ptr<Bot> bot)
+        : start([bot](const SnakeGrid &grid, std::uint64_t seed) {
+              if constexpr (GameAwarePolicy<Bot>) bot->start_game(grid, seed);
+          }),
+          decide([bot](const Snake &snake, const SnakeGrid &grid) -> std::optional<Direction> { return (*bot)(snake, grid); }) {}
+
+    void start_game(const SnakeGrid &grid, std::uint64_t seed) { start(grid, seed); }
+    std::optional<Direction> operator()(const Snake &snake, const SnakeGrid &grid) { return decide(snake, grid); }
+
+private:
+    std::function<void(const SnakeGrid &, std::uint64_t)> start;
+    std::function<std::optional<Direction>(const Snake &, const SnakeGrid &)> decide;
+};
+
+// MctsBot searches on a pool of its own; in a tournament each worker's bot
+// gets a one-thread pool, so the parallelism is across games instead.
+struct TournamentMcts {
+    TournamentMcts(std::size_t rollouts, std::uint64_t seed)
+        : pool(std::make_unique<WorkStealingPool>(1)),
+          bot(std::make_unique<MctsBot>(*pool, MctsSettings{.time_budget = 0, .max_rollouts = rollouts, .seed = seed})) {}
+
+    std::optional<Direction> operator()(const Snake &snake, const SnakeGrid &grid) { return (*bot)(snake, grid); }
+
+    std::unique_ptr<WorkStealingPool> pool;
+    std::unique_ptr<MctsBot> bot;
+};
+
+constexpr std::string_view BOT_NAMES[] = {"random", "path", "hamilton", "mcts"};
+
+std::optional<AnyBot> make_bot(std::string_view name, const TournamentSettings &settings, std::size_t worker) {
+    if (name == "random") return AnyBot(std::make_shared<RandomBot>());
+    if (name == "path") return AnyBot(std::make_shared<PathBot>());
+    if (name == "hamilton") return AnyBot(std::make_shared<HamiltonBot>());
+    if (name == "mcts") return AnyBot(std::make_shared<TournamentMcts>(settings.mcts_rollouts, derive_seed(settings.workload.seed, worker)));
+    return std::nullopt;
+}
+
+void print_usage() {
+    std::fputs("usage: SnakeTournament [--games N] [--width W] [--height H] [--seed S] [--max-ticks T]\n"
+               "                       [--threads N] [--mcts-rollouts N] [--versus] bot...\n"
+               "bots: random, path, hamilton, mcts\n",
+               stderr);
+}
+
+template <typename T>
+bool parse_number(std::string_view text, T &value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+std::optional<TournamentSettings> parse_arguments(int argc, char **argv) {
+    TournamentSettings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        const auto number = [&](auto &value) { return i + 1 < argc && parse_number(argv[++i], value); };
+
+        bool ok = true;
+        if (argument == "--games") ok = number(settings.workload.games);
+        else if (argument == "--width") ok = number(settings.workload.width);
+        else if (argument == "--height") ok = number(settings.workload.height);
+        else if (argument == "--seed") ok = number(settings.workload.seed);
+        else if (argument == "--max-ticks") ok = number(settings.workload.max_ticks);
+        else if (argument == "--threads") ok = number(settings.threads);
+        else if (argument == "--mcts-rollouts") ok = number(settings.mcts_rollouts);
+        else if (argument == "--versus") settings.versus = true;
+        else if (std::ranges::find(BOT_NAMES, argument) == std::end(BOT_NAMES)) ok = false;
+        else settings.bots.push_back(argument);
+
+        if (!ok) {
+            std::fprintf(stderr, "bad argument: %s\n", argv[i]);
+            return std::nullopt;
+        }
+    }
+
+    const Workload &workload = settings.workload;
+    // The snake starts on columns 1 to 4 and the first apple on column width - 3.
+    if (settings.bots.empty() || workload.width < 8 || workload.height < 2 || workload.width > 0xFFFF || workload.height > 0xFFFF) {
+        return std::nullopt;
+    }
+    // Without a cycle the bot never moves and every game runs to --max-ticks.
+    if (workload.width % 2 != 0 && workload.height % 2 != 0 && std::ranges::find(settings.bots, "hamilton") != settings.bots.end()) {
+        std::fprintf(stderr, "hamilton needs an even width or height; a %zux%zu board has no Hamiltonian cycle\n", workload.width,
+                     workload.height);
+        return std::nullopt;
+    }
+    return settings;
+}
+
+void print_header() {
+    std::printf("%-10s %10s %7s %7s %7s %7s %6s %6s %6s %6s %10s %12s %10s\n", "bot", "games", "win%", "wall%", "self%",
+                "tmout%", "p10", "p50", "p90", "max", "len@death", "ticks/s", "games/s");
+}
+
+void print_stats(std::string_view name, const GameStats &stats) {
+    const auto percent = [&](std::size_t count) { return stats.games > 0 ? 100.0 * static_cast<double>(count) / static_cast<double>(stats.games) : 0.0; };
+    const std::size_t deaths = stats.wall_deaths + stats.self_deaths;
+    const double length_at_death = deaths > 0 ? static_cast<double>(stats.death_length_sum) / static_cast<double>(deaths) : 0;
+
+    std::printf("%-10.*s %10zu %7.2f %7.2f %7.2f %7.2f %6zu %6zu %6zu %6zu %10.1f %12.0f %10.0f\n",
+                static_cast<int>(name.size()), name.data(), stats.games, percent(stats.wins), percent(stats.wall_deaths),
+                percent(stats.self_deaths), percent(stats.timeouts), stats.apple_quantile(0.1), stats.apple_quantile(0.5),
+                stats.apple_quantile(0.9), stats.apple_histogram.empty() ? 0 : stats.apple_histogram.size() - 1,
+                length_at_death, stats.ticks_per_second(), stats.games_per_second());
+}
+
+void run_solo(WorkStealingPool &pool, const TournamentSettings &settings) {
+    for (const std::string_view name : settings.bots) {
+        const GameStats stats = run_games(pool, settings.workload, [&](std::size_t worker) { return *make_bot(name, settings, worker); });
+        print_stats(name, stats);
+    }
+}
+
+void run_versus(WorkStealingPool &pool, const TournamentSettings &settings) {
+    const std::size_t bot_count = settings.bots.size();
+
+    struct alignas(64) WorkerState {
+        std::vector<AnyBot> bots;
+        std::vector<GameStats> stats;
+        std::vector<std::size_t> scores;
+        // beats[i * bot_count + j]: games where bot i ate more apples than bot j.
+        std::vector<std::size_t> beats;
+    };
+
+    std::vector<WorkerState> workers(pool.get_thread_count());
+    for (std::size_t worker = 0; worker < workers.size(); ++worker) {
+        WorkerState &state = workers[worker];
+        for (const std::string_view name : settings.bots) state.bots.push_back(*make_bot(name, settings, worker));
+        state.stats.resize(bot_count);
+        state.scores.resize(bot_count);
+        state.beats.resize(bot_count * bot_count);
+    }
+
+    Timer timer;
+    timer.start();
+
+    pool.parallel_for(settings.workload.games, [&](std::size_t game, std::size_t worker) {
+        WorkerState &state = workers[worker];
+        for (std::size_t bot = 0; bot < bot_count; ++bot) {
+            state.scores[bot] = play_game(settings.workload, game, state.bots[bot], state.stats[bot]);
+        }
+        for (std::size_t i = 0; i < bot_count; ++i) {
+            for (std::size_t j = 0; j < bot_count; ++j) state.beats[i * bot_count + j] += state.scores[i] > state.scores[j];
+        }
+    });
+
+    const double seconds = timer.elapsed<std::chrono::duration<double>>().count();
+    std::vector<GameStats> totals(bot_count);
+    std::vector<std::size_t> beats(bot_count * bot_count);
+    for (const WorkerState &state : workers) {
+        for (std::size_t bot = 0; bot < bot_count; ++bot) totals[bot].merge(state.stats[bot]);
+        for (std::size_t i = 0; i < beats.size(); ++i) beats[i] += state.beats[i];
+    }
+
+    // Every bot shares the wall time, so the rates are for the whole field.
+    for (std::size_t bot = 0; bot < bot_count; ++bot) {
+        totals[bot].seconds = seconds;
+        print_stats(settings.bots[bot], totals[bot]);
+    }
+
+    std::printf("\nhead to head, %% of games where the row bot ate more apples than the column bot:\n%-10s", "");
+    for (const std::string_view name : settings.bots) std::printf(" %10.*s", static_cast<int>(name.size()), name.data());
+    std::printf("\n");
+    for (std::size_t i = 0; i < bot_count; ++i) {
+        std::printf("%-10.*s", static_cast<int>(settings.bots[i].size()), settings.bots[i].data());
+        for (std::size_t j = 0; j < bot_count; ++j) {
+            std::printf(" %10.2f", 100.0 * static_cast<double>(beats[i * bot_count + j]) / static_cast<double>(settings.workload.games));
+        }
+        std::printf("\n");
+    }
+    std::printf("\n%.0f games/s over all bots\n", static_cast<double>(settings.workload.games * bot_count) / seconds);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const std::optional<TournamentSettings> settings = parse_arguments(argc, argv);
+    if (!settings) {
+        print_usage();
+        return 1;
+    }
+
+    WorkStealingPool pool(settings->threads);
+    const Workload &workload = settings->workload;
+    std::printf("%zu games on %zux%zu, seed %llu, %zu threads\n\n", workload.games, workload.width, workload.height,
+                static_cast<unsigned long long>(workload.seed), pool.get_thread_count());
+    print_header();
+
+    if (settings->versus) {
+        run_versus(pool, *settings);
+    } else {
+        run_solo(pool, *settings);
+    }
+    return 0;
+}
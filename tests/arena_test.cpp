@@ -0,0 +1,151 @@
+// Arena::tick(WorkStealingPool &) against the serial Arena::tick(): two
+// copies of the same seeded arena, stepped with the same steering, must agree
+// on every cell, body, apple and event after every tick.
+
+#include "check.hpp"
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+struct Coverage {
+    std::size_t head_on = 0;
+    std::size_t other = 0;
+    std::size_t self = 0;
+    std::size_t wall = 0;
+    std::size_t apples = 0;
+};
+
+bool same_events(const TickEvents &a, const TickEvents &b) {
+    return a.moved == b.moved && a.grew == b.grew && a.death == b.death &&
+           (!a.moved || (a.head == b.head && a.freed_tail == b.freed_tail)) && (!a.grew || a.apple == b.apple);
+}
+
+void check_same(const Arena &serial, const Arena &parallel, std::size_t tick) {
+    const ArenaGrid &grid = serial.get_grid();
+    CHECK_MSG(serial.get_snake_count() == parallel.get_snake_count(), "tick %zu", tick);
+    CHECK_MSG(serial.get_alive_count() == parallel.get_alive_count(), "tick %zu", tick);
+    CHECK_MSG(std::ranges::equal(serial.get_apples(), parallel.get_apples()), "tick %zu", tick);
+    CHECK_MSG(grid.get_free_cell_count() == parallel.get_grid().get_free_cell_count(), "tick %zu", tick);
+    for (std::size_t cell = 0; cell < grid.get_width() * grid.get_height(); ++cell) {
+        CHECK_MSG(grid.get_cell(cell) == parallel.get_grid().get_cell(cell), "cell %zu at tick %zu", cell, tick);
+    }
+
+    for (std::size_t snake = 0; snake < serial.get_snake_count(); ++snake) {
+        CHECK_MSG(serial.is_alive(snake) == parallel.is_alive(snake), "snake %zu at tick %zu", snake, tick);
+        CHECK_MSG(serial.get_direction(snake) == parallel.get_direction(snake), "snake %zu at tick %zu", snake, tick);
+        CHECK_MSG(same_events(serial.get_events(snake), parallel.get_events(snake)), "snake %zu at tick %zu", snake, tick);
+
+        const BodyView body = serial.get_body(snake);
+        const BodyView other_body = parallel.get_body(snake);
+        CHECK_MSG(body.size() == other_body.size(), "snake %zu at tick %zu", snake, tick);
+        for (std::size_t i = 0; i < body.size(); ++i) {
+            CHECK_MSG(body[i] == other_body[i], "snake %zu segment %zu at tick %zu", snake, i, tick);
+        }
+    }
+}
+
+void count(const Arena &arena, Coverage &coverage) {
+    for (std::size_t snake = 0; snake < arena.get_snake_count(); ++snake) {
+        const TickEvents &events = arena.get_events(snake);
+        coverage.head_on += events.death == DeathCause::HEAD_ON;
+        coverage.other += events.death == DeathCause::OTHER;
+        coverage.self += events.death == DeathCause::SELF;
+        coverage.wall += events.death == DeathCause::WALL;
+        coverage.apples += events.grew;
+    }
+}
+
+// Hand-placed collisions, each checked for the expected outcome.
+void test_scripted(WorkStealingPool &pool) {
+    Arena serial(20, 20, 0, 1);
+    Arena parallel(20, 20, 0, 1);
+    for (Arena *arena : {&serial, &parallel}) {
+        // Four heads into (10, 10) from every side.
+        CHECK(arena->add_snake({10, 9}, Direction::RIGHT, 2) == 0);
+        CHECK(arena->add_snake({10, 11}, Direction::LEFT, 2) == 1);
+        CHECK(arena->add_snake({9, 10}, Direction::DOWN, 2) == 2);
+        CHECK(arena->add_snake({11, 10}, Direction::UP, 2) == 3);
+        // Head to head: each moves into the other's head.
+        CHECK(arena->add_snake({3, 3}, Direction::RIGHT, 2) == 4);
+        CHECK(arena->add_snake({3, 4}, Direction::LEFT, 2) == 5);
+        // Snake 7 follows into snake 6's vacated tail cell (6, 3).
+        CHECK(arena->add_snake({6, 5}, Direction::RIGHT, 3) == 6);
+        CHECK(arena->add_snake({5, 3}, Direction::DOWN, 2) == 7);
+        // Two heads into the empty cell (15, 15).
+        CHECK(arena->add_snake({15, 14}, Direction::RIGHT, 2) == 8);
+        CHECK(arena->add_snake({14, 15}, Direction::DOWN, 2) == 9);
+        // One-cell snakes swapping cells: each head is also a tail about to move.
+        CHECK(arena->add_snake({18, 3}, Direction::RIGHT, 1) == 10);
+        CHECK(arena->add_snake({18, 4}, Direction::LEFT, 1) == 11);
+        // Into a head that moves away: the cell is still body, so OTHER.
+        CHECK(arena->add_snake({1, 14}, Direction::RIGHT, 2) == 12);
+        CHECK(arena->add_snake({1, 15}, Direction::DOWN, 2) == 13);
+    }
+
+    serial.tick();
+    parallel.tick(pool);
+    check_same(serial, parallel, 0);
+
+    for (const std::size_t snake : {0, 1, 2, 3, 4, 5, 8, 9, 10, 11}) CHECK(serial.get_events(snake).death == DeathCause::HEAD_ON);
+    CHECK(serial.get_events(12).death == DeathCause::OTHER);
+    CHECK(serial.is_alive(6) && serial.is_alive(7) && serial.is_alive(13));
+    CHECK(serial.get_body(7).front() == (Position{6, 3}));
+}
+
+// A crowded arena with random steering and snakes joining every tick.
+void test_random(WorkStealingPool &pool, std::size_t width, std::size_t height, std::size_t ticks, std::uint64_t seed, Coverage &coverage) {
+    Arena serial(width, height, width * height / 50, seed);
+    Arena parallel(width, height, width * height / 50, seed);
+    Xoshiro256 rng(seed);
+
+    const auto add_random_snakes = [&](std::size_t attempts) {
+        for (std::size_t i = 0; i < attempts; ++i) {
+            const Position head{static_cast<std::uint16_t>(random_below(rng, height)), static_cast<std::uint16_t>(random_below(rng, width))};
+            const auto heading = static_cast<Direction>(random_below(rng, 4));
+            const std::size_t length = 1 + random_below(rng, 8);
+            const std::optional<std::size_t> added = serial.add_snake(head, heading, length);
+            CHECK(added == parallel.add_snake(head, heading, length));
+        }
+    };
+
+    add_random_snakes(width * height / 12);
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        for (std::size_t snake = 0; snake < serial.get_snake_count(); ++snake) {
+            if (!serial.is_alive(snake) || random_below(rng, 4) != 0) continue;
+            const auto direction = static_cast<Direction>(random_below(rng, 4));
+            serial.steer(snake, direction);
+            parallel.steer(snake, direction);
+        }
+
+        serial.tick();
+        parallel.tick(pool);
+        check_same(serial, parallel, tick);
+        count(serial, coverage);
+
+        add_random_snakes(width * height / 400);
+    }
+}
+
+} // namespace
+
+int main() {
+    WorkStealingPool pool(4);
+    test_scripted(pool);
+
+    Coverage coverage;
+    test_random(pool, 200, 150, 200, 1, coverage);
+    test_random(pool, 64, 64, 300, 2, coverage);
+
+    std::printf("head-on %zu, other %zu, self %zu, wall %zu, apples %zu\n", coverage.head_on, coverage.other, coverage.self,
+                coverage.wall, coverage.apples);
+    CHECK(coverage.head_on > 0);
+    CHECK(coverage.other > 0);
+    CHECK(coverage.self > 0);
+    CHECK(coverage.wall > 0);
+    CHECK(coverage.apples > 0);
+    return 0;
+}
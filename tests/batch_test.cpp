@@ -0,0 +1,132 @@
+// SnakeBatch against Snake on a SnakeGrid, in lockstep: every game gets the
+// same turn on both sides, the batch's respawned apples are copied into the
+// grid, and the two must match after every tick.
+
+#include "check.hpp"
+
+#include "batch.hpp"
+#include "path_bot.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// How a game picks its turns, chosen to reach every rule of the engine.
+enum class Script {
+    RANDOM,
+    // Shortest path to the apple: grows and chases its tail.
+    PATH,
+    // Clockwise around a 2x2 square, entering the tail cell every tick.
+    CIRCLE,
+    // PATH until the snake is long enough, then clockwise into its own body.
+    CURL,
+    // Straight on into the wall.
+    STRAIGHT,
+};
+
+constexpr Script SCRIPTS[] = {Script::RANDOM, Script::PATH, Script::CIRCLE, Script::CURL, Script::STRAIGHT};
+
+struct ScalarGame {
+    ScalarGame(std::size_t width, std::size_t height, std::uint64_t seed, Script script)
+        : grid(width, height, seed), snake(grid, Position{static_cast<std::uint16_t>(height / 2), 4}), rng(seed), script(script) {}
+
+    bool is_running() const { return !snake.has_state<DeadSnake>() && !snake.has_state<WinnerSnake>(); }
+
+    Direction choose() {
+        const Direction heading = snake.get_next_direction();
+        const Direction clockwise = static_cast<Direction>((static_cast<int>(heading) + 1) % 4);
+        switch (script) {
+        case Script::RANDOM:
+            return static_cast<Direction>(random_below(rng, 4));
+        case Script::PATH:
+            return path_bot(snake, grid).value_or(heading);
+        case Script::CIRCLE:
+            return clockwise;
+        case Script::CURL:
+            return snake.get_body().size() < 6 ? path_bot(snake, grid).value_or(heading) : clockwise;
+        case Script::STRAIGHT:
+            return heading;
+        }
+        return heading;
+    }
+
+    SnakeGrid grid;
+    Snake snake;
+    Xoshiro256 rng;
+    PathBot path_bot;
+    Script script;
+};
+
+struct Coverage {
+    std::size_t wall_deaths = 0;
+    std::size_t self_deaths = 0;
+    std::size_t tail_chases = 0;
+    std::size_t apples = 0;
+    std::size_t wins = 0;
+};
+
+void run_lockstep(std::size_t width, std::size_t height, std::size_t games, std::uint64_t seed, std::size_t max_ticks, Coverage &coverage) {
+    SnakeBatch batch(games, width, height, seed);
+    std::vector<ScalarGame> scalars;
+    scalars.reserve(games);
+    for (std::size_t game = 0; game < games; ++game) {
+        scalars.emplace_back(width, height, derive_seed(seed, game), SCRIPTS[game % std::size(SCRIPTS)]);
+    }
+
+    std::vector<Direction> actions(games, Direction::RIGHT);
+    for (std::size_t tick = 0; tick < max_ticks; ++tick) {
+        bool any_alive = false;
+        for (std::size_t game = 0; game < games; ++game) {
+            ScalarGame &scalar = scalars[game];
+            if (!scalar.is_running()) continue;
+            any_alive = true;
+
+            actions[game] = scalar.choose();
+            const Position tail = scalar.snake.get_body().back();
+            // A batch game sets off on its first step even if told to reverse;
+            // a Snake waits for a direction it accepts.
+            if (!scalar.snake.push_direction(actions[game]) && scalar.snake.has_state<PreStartSnake>()) {
+                scalar.snake.push_direction(Direction::RIGHT);
+            }
+            const TickEvents events = scalar.snake.update(scalar.grid);
+
+            if (events.grew) {
+                ++coverage.apples;
+            } else if (events.moved && events.head == tail) {
+                ++coverage.tail_chases;
+            }
+            coverage.wall_deaths += events.death == DeathCause::WALL;
+            coverage.self_deaths += events.death == DeathCause::SELF;
+            coverage.wins += scalar.snake.has_state<WinnerSnake>();
+        }
+        if (!any_alive) break;
+
+        batch.step(actions);
+        for (std::size_t game = 0; game < games; ++game) {
+            if (batch.has_grown(game)) scalars[game].grid.place_apple(batch.get_apple_position(game));
+            CHECK_MSG(batch.matches(game, scalars[game].snake, scalars[game].grid), "%zux%zu game %zu diverged at tick %zu",
+                      width, height, game, tick);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    Coverage coverage;
+    run_lockstep(10, 9, 250, 1, 2'000, coverage);
+    // Small enough for the path bot to fill now and then.
+    run_lockstep(8, 2, 250, 2, 2'000, coverage);
+    run_lockstep(23, 17, 150, 3, 2'000, coverage);
+    run_lockstep(120, 80, 5, 4, 2'000, coverage);
+
+    std::printf("wall deaths %zu, self deaths %zu, tail chases %zu, apples %zu, wins %zu\n", coverage.wall_deaths,
+                coverage.self_deaths, coverage.tail_chases, coverage.apples, coverage.wins);
+    CHECK(coverage.wall_deaths > 0);
+    CHECK(coverage.self_deaths > 0);
+    CHECK(coverage.tail_chases > 0);
+    CHECK(coverage.apples > 0);
+    CHECK(coverage.wins > 0);
+    return 0;
+}
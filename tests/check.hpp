@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// Stops the test with the failed condition and where it was checked.
+#define CHECK(condition)                                                                      \
+    do {                                                                                      \
+        if (!(condition)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            std::exit(EXIT_FAILURE);                                                          \
+        }                                                                                     \
+    } while (false)
+
+// CHECK with a printf-style note, e.g. the game and tick that diverged.
+#define CHECK_MSG(condition, ...)                                                             \
+    do {                                                                                      \
+        if (!(condition)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed: ", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__);                                                \
+            std::fputc('\n', stderr);                                                         \
+            std::exit(EXIT_FAILURE);                                                          \
+        }                                                                                     \
+    } while (false)
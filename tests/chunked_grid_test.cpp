@@ -0,0 +1,103 @@
+// ChunkedSnakeGrid against the dense 32-bit SnakeGrid: the same snake moves
+// on both, with the chunked grid's apples copied across, and the two must
+// agree on free cells, hash and which chunks hold body cells.
+
+#include "check.hpp"
+
+#include "chunked_grid.hpp"
+#include "snake.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using DenseGrid = BasicSnakeGrid<DynamicExtent<std::uint32_t>>;
+using WideSnake = BasicSnake<std::uint32_t>;
+
+// Chunks holding body cells, which the chunked grid must have allocated; the
+// body is every occupied cell of the dense grid.
+std::size_t occupied_chunks(const DenseGrid &grid, const WideSnake &snake) {
+    std::vector<std::size_t> chunks;
+    const auto body = snake.get_body();
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        CHECK(grid.is_snake_body(body[i]));
+        chunks.push_back(body[i].row / ChunkedSnakeGrid::CHUNK_SIZE * grid.get_width() + body[i].col / ChunkedSnakeGrid::CHUNK_SIZE);
+    }
+    std::ranges::sort(chunks);
+    return static_cast<std::size_t>(std::ranges::unique(chunks).begin() - chunks.begin());
+}
+
+void test_lockstep(std::size_t width, std::size_t height, std::size_t games, std::size_t max_ticks, std::size_t &apples) {
+    for (std::size_t game = 0; game < games; ++game) {
+        DenseGrid dense(width, height, game);
+        ChunkedSnakeGrid chunked(width, height, game);
+        const BasicPosition<std::uint32_t> start{static_cast<std::uint32_t>(height / 2), 4};
+        WideSnake dense_snake(dense, start);
+        WideSnake chunked_snake(chunked, start);
+        Xoshiro256 rng(game);
+
+        for (std::size_t tick = 0; tick < max_ticks && !chunked_snake.has_state<DeadSnake>(); ++tick) {
+            // Towards the apple with the odd random turn, so the snake grows,
+            // crosses chunk borders and frees chunks behind it.
+            const auto head = chunked_snake.get_body().front();
+            const auto apple = chunked.get_apple_position();
+            Direction direction = apple.col > head.col   ? Direction::RIGHT
+                                  : apple.col < head.col ? Direction::LEFT
+                                  : apple.row > head.row ? Direction::DOWN
+                                                         : Direction::UP;
+            if (random_below(rng, 8) == 0) direction = static_cast<Direction>(random_below(rng, 4));
+            dense_snake.push_direction(direction);
+            chunked_snake.push_direction(direction);
+
+            const auto dense_events = dense_snake.update(dense);
+            const auto chunked_events = chunked_snake.update(chunked);
+            if (chunked_events.grew) {
+                ++apples;
+                dense.place_apple(chunked.get_apple_position());
+            }
+
+            CHECK_MSG(dense_events.death == chunked_events.death && dense_events.grew == chunked_events.grew, "game %zu tick %zu", game, tick);
+            CHECK_MSG(dense.get_free_cell_count() == chunked.get_free_cell_count(), "game %zu tick %zu", game, tick);
+            CHECK_MSG(dense.get_hash() == chunked.get_hash(), "game %zu tick %zu", game, tick);
+            CHECK_MSG(occupied_chunks(dense, dense_snake) == chunked.get_allocated_chunk_count(), "game %zu tick %zu", game, tick);
+        }
+    }
+}
+
+// Equality must not depend on the order chunks were allocated in.
+void test_equality() {
+    ChunkedSnakeGrid a(300, 200, 1);
+    ChunkedSnakeGrid b(300, 200, 1);
+    const ChunkedSnakeGrid::position_type near{1, 1}, far{150, 250}, gone{100, 100};
+
+    a.set_snake_body(near, true);
+    a.set_snake_body(gone, true);
+    a.set_snake_body(far, true);
+    a.set_snake_body(gone, false);
+    b.set_snake_body(far, true);
+    b.set_snake_body(near, true);
+    CHECK(a == b);
+
+    b.set_snake_body(gone, true);
+    CHECK(!(a == b));
+    b.set_snake_body(gone, false);
+    CHECK(a == b);
+
+    b.place_apple(gone);
+    CHECK(!(a == b));
+}
+
+} // namespace
+
+int main() {
+    std::size_t apples = 0;
+    test_lockstep(70, 67, 300, 3'000, apples);
+    test_lockstep(300, 130, 10, 3'000, apples);
+    test_equality();
+
+    std::printf("apples %zu\n", apples);
+    CHECK(apples > 0);
+    return 0;
+}
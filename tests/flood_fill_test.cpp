@@ -0,0 +1,130 @@
+// FloodFill::fill against a breadth-first search on random and winding
+// boards, and select_bit against a bit-by-bit scan. Built twice when the
+// compiler can target AVX2: once as the library is configured and once with
+// AVX2 and BMI2, so the scalar and the SIMD paths are both checked.
+
+#include "check.hpp"
+
+#include "flood_fill.hpp"
+#include "random.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Board with row-major occupancy as SnakeGrid stores it, padding bits set.
+struct Board {
+    Board(std::size_t width, std::size_t height) : width(width), height(height), occupancy(word_count(width * height)) {
+        for (std::size_t cell = width * height; cell < occupancy.size() * WORD_BITS; ++cell) block(cell);
+    }
+
+    void block(std::size_t cell) { occupancy[cell / WORD_BITS] |= std::uint64_t{1} << (cell % WORD_BITS); }
+    bool is_open(std::size_t cell) const { return !((occupancy[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1); }
+
+    std::size_t width;
+    std::size_t height;
+    std::vector<std::uint64_t> occupancy;
+};
+
+// Cells reachable from start, marked in reached.
+std::size_t breadth_first(const Board &board, std::size_t start, std::vector<bool> &reached) {
+    reached.assign(board.width * board.height, false);
+    if (!board.is_open(start)) return 0;
+
+    std::vector<std::size_t> frontier{start};
+    reached[start] = true;
+    for (std::size_t read = 0; read < frontier.size(); ++read) {
+        const std::size_t cell = frontier[read];
+        const std::size_t row = cell / board.width;
+        const std::size_t col = cell % board.width;
+        const auto visit = [&](std::size_t next) {
+            if (reached[next] || !board.is_open(next)) return;
+            reached[next] = true;
+            frontier.push_back(next);
+        };
+        if (col + 1 < board.width) visit(cell + 1);
+        if (col > 0) visit(cell - 1);
+        if (row + 1 < board.height) visit(cell + board.width);
+        if (row > 0) visit(cell - board.width);
+    }
+    return frontier.size();
+}
+
+void check_fill(FloodFill &flood_fill, const Board &board, std::size_t start, const char *what) {
+    RowBitboard passable(board.width, board.height);
+    passable.assign_free_cells(board.occupancy);
+
+    std::vector<bool> reached;
+    const std::size_t expected = breadth_first(board, start, reached);
+    const std::size_t row = start / board.width;
+    const std::size_t col = start % board.width;
+    CHECK_MSG(flood_fill.fill(passable, row, col) == expected, "%s %zux%zu from (%zu, %zu)", what, board.width, board.height, row, col);
+    CHECK(flood_fill.get_region().count() == expected);
+    for (std::size_t cell = 0; cell < board.width * board.height; ++cell) {
+        CHECK_MSG(flood_fill.get_region().test(cell / board.width, cell % board.width) == reached[cell], "%s %zux%zu cell %zu", what,
+                  board.width, board.height, cell);
+    }
+}
+
+void test_random(FloodFill &flood_fill) {
+    Xoshiro256 rng(1);
+    for (std::size_t round = 0; round < 3'000; ++round) {
+        // Up to five words per row, so the four-word blocks have a remainder.
+        Board board(1 + random_below(rng, 300), 1 + random_below(rng, 60));
+        const std::uint64_t density = random_below(rng, 100);
+        for (std::size_t cell = 0; cell < board.width * board.height; ++cell) {
+            if (random_below(rng, 100) < density) board.block(cell);
+        }
+        check_fill(flood_fill, board, random_below(rng, board.width * board.height), "random");
+    }
+}
+
+// Walls in every other column with the gap alternating between the top and
+// bottom row: one path that winds across the whole board.
+void test_serpentine(FloodFill &flood_fill, std::size_t size) {
+    Board board(size, size);
+    for (std::size_t col = 1; col < size; col += 2) {
+        const std::size_t gap = col / 2 % 2 == 0 ? size - 1 : 0;
+        for (std::size_t row = 0; row < size; ++row) {
+            if (row != gap) board.block(row * size + col);
+        }
+    }
+    check_fill(flood_fill, board, 0, "serpentine");
+    check_fill(flood_fill, board, size * size - 1, "serpentine");
+}
+
+void test_select_bit() {
+    Xoshiro256 rng(2);
+    for (std::size_t round = 0; round < 10'000; ++round) {
+        const std::uint64_t word = rng() & rng();
+        unsigned k = 0;
+        for (unsigned bit = 0; bit < WORD_BITS; ++bit) {
+            if (!((word >> bit) & 1)) continue;
+            CHECK_MSG(select_bit(word, k) == bit, "word %016llx, k %u", static_cast<unsigned long long>(word), k);
+            ++k;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+#if defined(__AVX2__) && defined(__GNUC__)
+    // This copy is built for AVX2 whatever the host; skip rather than crash.
+    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("bmi2")) return 77;
+#endif
+
+    test_select_bit();
+
+    FloodFill flood_fill;
+    test_random(flood_fill);
+    for (const std::size_t size : {1, 2, 63, 64, 65, 130, 257}) test_serpentine(flood_fill, size);
+
+#if defined(__AVX2__)
+    std::puts("AVX2 and BMI2 paths checked");
+#else
+    std::puts("scalar paths checked");
+#endif
+    return 0;
+}
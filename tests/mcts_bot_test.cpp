@@ -0,0 +1,56 @@
+// MctsBot must never pick a move that dies at once while a safe one exists.
+// Plays seeded games and checks every decision against the four neighbours.
+
+#include "check.hpp"
+
+#include "mcts_bot.hpp"
+
+#include <cstdio>
+
+namespace {
+
+// Whether moving the snake in direction survives the next tick.
+bool is_safe(const Snake &snake, const SnakeGrid &grid, Direction direction) {
+    const BodyView body = snake.get_body();
+    const std::optional<Position> next = grid.move_head(body.front(), direction);
+    return next && (!grid.is_snake_body(*next) || *next == body.back());
+}
+
+} // namespace
+
+int main() {
+    WorkStealingPool pool(2);
+    std::size_t decisions = 0;
+    std::size_t deaths = 0;
+    std::size_t apples = 0;
+
+    for (std::uint64_t game = 0; game < 12; ++game) {
+        MctsBot bot(pool, MctsSettings{.time_budget = 0, .max_rollouts = 32, .rollout_depth = 32, .seed = game});
+        SnakeGrid grid(10, 9, derive_seed(1, game));
+        Snake snake(grid, Position{4, 4});
+
+        for (std::size_t tick = 0; tick < 400 && !snake.has_state<DeadSnake>() && !snake.has_state<WinnerSnake>(); ++tick) {
+            const std::optional<Direction> choice = bot(snake, grid);
+            // No turn, or a reversal, leaves the snake going straight on.
+            const Direction heading = snake.get_next_direction();
+            const Direction move = choice && !is_opposite(heading, *choice) ? *choice : heading;
+
+            bool any_safe = false;
+            for (const Direction direction : {Direction::RIGHT, Direction::DOWN, Direction::LEFT, Direction::UP}) {
+                any_safe |= !is_opposite(heading, direction) && is_safe(snake, grid, direction);
+            }
+            CHECK_MSG(!any_safe || is_safe(snake, grid, move), "game %llu tick %zu: fatal move with a safe one available",
+                      static_cast<unsigned long long>(game), tick);
+
+            if (choice) snake.push_direction(*choice);
+            const TickEvents events = snake.update(grid);
+            apples += events.grew;
+            deaths += events.death != DeathCause::NONE;
+            ++decisions;
+        }
+    }
+
+    std::printf("decisions %zu, apples %zu, deaths %zu\n", decisions, apples, deaths);
+    CHECK(apples > 0);
+    return 0;
+}
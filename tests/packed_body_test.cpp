@@ -0,0 +1,74 @@
+// PackedBody against RingBody: the same random pushes and pops on both, and
+// the packed body must decode to the ring body after every one.
+
+#include "check.hpp"
+
+#include "packed_body.hpp"
+
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+static_assert(std::input_iterator<PackedBody::iterator>);
+
+void check_same(const RingBody &ring, const PackedBody &packed, std::vector<Position> &decoded, std::size_t step) {
+    CHECK_MSG(ring.size() == packed.size(), "step %zu", step);
+    if (ring.size() == 0) return;
+
+    CHECK_MSG(ring.front() == packed.front() && ring.back() == packed.back(), "step %zu", step);
+    std::size_t i = 0;
+    for (const Position position : packed) {
+        CHECK_MSG(position == ring[i], "segment %zu at step %zu", i, step);
+        ++i;
+    }
+    CHECK_MSG(i == ring.size(), "step %zu", step);
+
+    packed.decode(decoded);
+    CHECK_MSG(decoded.size() == ring.size(), "step %zu", step);
+    CHECK_MSG(PackedBody(ring.view()) == packed, "step %zu", step);
+}
+
+// A random walk that grows to target_length and then shrinks back, with
+// pushes and pops mixed so the link ring wraps and grows.
+void test_walk(std::uint64_t seed, std::size_t target_length, std::size_t &steps) {
+    RingBody ring;
+    PackedBody packed;
+    std::vector<Position> decoded;
+    Xoshiro256 rng(seed);
+
+    Position head{0x8000, 0x8000};
+    ring.push_front(head);
+    packed.push_front(head);
+
+    for (bool growing = true; ring.size() > 0; ++steps) {
+        if (growing && ring.size() >= target_length) growing = false;
+
+        // Grow three times in four while growing, shrink three times in four after.
+        const bool push = random_below(rng, 4) != 0 ? growing : !growing;
+        if (push) {
+            head = *step_position(head, static_cast<Direction>(random_below(rng, 4)), 0x10000, 0x10000);
+            ring.push_front(head);
+            packed.push_front(head);
+        } else {
+            ring.pop_back();
+            packed.pop_back();
+        }
+
+        // Full comparisons are O(length); keep them sparse on long bodies.
+        if (ring.size() < 300 || steps % 9'973 == 0) check_same(ring, packed, decoded, steps);
+        CHECK_MSG(ring.size() == 0 || (ring.front() == packed.front() && ring.back() == packed.back()), "step %zu", steps);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::size_t steps = 0;
+    for (std::uint64_t seed = 0; seed < 200; ++seed) test_walk(seed, 1 + seed % 150, steps);
+    test_walk(1'000, 100'000, steps);
+
+    std::printf("steps %zu\n", steps);
+    return 0;
+}